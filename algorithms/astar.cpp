@@ -7,14 +7,22 @@ using Cell = Grid::Cell;
 
 namespace SearchAlgorithms {
 
-AStar::AStar(std::shared_ptr<Grid> grid, const std::shared_ptr<Cell> start,
-    const std::shared_ptr<Cell> goal)
+template <bool Visualize>
+BasicAStar<Visualize>::BasicAStar(std::shared_ptr<Grid> grid,
+    const std::shared_ptr<Cell> start, const std::shared_ptr<Cell> goal,
+    std::shared_ptr<const DeadEndPruning> pruning)
+    : pruning_(pruning)
 {
   // Init grid
   this->grid_ = grid;
   this->startCell_ = start;
   this->goalCell_ = goal;
 
+  // If the goal is walled off, fail before building any search state.
+  if (finishIfUnreachable(*grid_, startCell_, goalCell_)) {
+    return;
+  }
+
   /*
    * Ensure that cells do not have any data left over from previous searches.
    * Search data is cleared and visualization state is reset.
@@ -45,11 +53,14 @@ AStar::AStar(std::shared_ptr<Grid> grid, const std::shared_ptr<Cell> start,
 
   // Add start cell to open list
   auto searchData = new SearchData;
+  count().state(sizeof(SearchData));
   startCell_->searchData = searchData;
   pQueue.push(startCell_);
+  count().push(pQueue.size());
 }
 
-AStar::~AStar()
+template <bool Visualize>
+BasicAStar<Visualize>::~BasicAStar()
 {
   // Clear search data
   for (int x = 0; x < grid_->getWidth(); x++) {
@@ -64,13 +75,19 @@ AStar::~AStar()
   }
 }
 
-std::vector<std::shared_ptr<Grid::Cell>> AStar::step()
+template <bool Visualize>
+SearchAlgorithm::Status BasicAStar<Visualize>::expand(CellEventBuffer* events)
 {
-  std::vector<std::shared_ptr<Grid::Cell>> updatedCells;
+  // Without visualization nothing is recorded, so everything that depends on the
+  // event buffer compiles away.
+  if (!Visualize) {
+    events = nullptr;
+  }
+  const bool annotate = annotating(events);
 
   // Check if the open list is empty
   if (pQueue.empty()) {
-    throw NoPathFoundException(); // No path was found
+    return Status::NO_PATH; // No path was found
   }
 
   // Get the cell with the lowest cost
@@ -80,7 +97,7 @@ std::vector<std::shared_ptr<Grid::Cell>> AStar::step()
   auto searchData = (SearchData*)(cell->searchData);
 
   // If the goal has been found, the path can be reconstructed.
-  // An empty vector will be returned, indicating that the algorithm is finished.
+  // FOUND will be returned, indicating that the algorithm is finished.
   if (cell == goalCell_) {
 
     /*
@@ -104,7 +121,7 @@ std::vector<std::shared_ptr<Grid::Cell>> AStar::step()
 
     std::cout << "Path found!" << std::endl;
 
-    return updatedCells;
+    return Status::FOUND;
   }
 
   // Remove the cell from the open list.
@@ -115,7 +132,7 @@ std::vector<std::shared_ptr<Grid::Cell>> AStar::step()
   if (cell != startCell_) {
     cell->vis = Cell::VisualizationState::CLOSED_LIST;
   }
-  updatedCells.push_back(cell);
+  record(events, cell);
 
   // Get the neighbors of the cell.
   std::vector<std::shared_ptr<Grid::Cell>> neighbors = grid_->getNeighbors(cell);
@@ -133,12 +150,18 @@ std::vector<std::shared_ptr<Grid::Cell>> AStar::step()
    */
 
   for (auto neighbor : neighbors) {
+    // Dead ends and swamps cannot be on an optimal path, so they are never opened.
+    if (pruned(neighbor)) {
+      continue;
+    }
+
     auto neighborSD = (SearchData*)(neighbor->searchData);
     unsigned int newG = searchData->g + neighbor->cost;
 
     // Neighbor is unvisited.
     if (neighborSD == nullptr) {
       neighborSD = new SearchData;
+      count().state(sizeof(SearchData));
 
       // If the neighbor is a wall, it is added to the closed list.
       if (neighbor->cost == Cell::WALL_COST) {
@@ -147,18 +170,22 @@ std::vector<std::shared_ptr<Grid::Cell>> AStar::step()
       }
 
       neighborSD->g = newG;
-      neighborSD->h = abs(neighbor->x - goalCell_->x) + abs(neighbor->y - goalCell_->y);
+      neighborSD->h
+          = Heuristics::manhattan(neighbor->x, neighbor->y, goalCell_->x, goalCell_->y);
       neighborSD->f = neighborSD->g + neighborSD->h;
-      neighbor->text_tr = std::to_string(neighborSD->f);
-      neighbor->text_bl = std::to_string(neighborSD->g);
-      neighbor->text_br = std::to_string(neighborSD->h);
+      if (annotate) {
+        neighbor->text_tr = std::to_string(neighborSD->f);
+        neighbor->text_bl = std::to_string(neighborSD->g);
+        neighbor->text_br = std::to_string(neighborSD->h);
+      }
       neighborSD->parent = cell;
       neighbor->searchData = neighborSD;
       pQueue.push(neighbor);
+      count().push(pQueue.size());
       if (neighbor != goalCell_) {
         neighbor->vis = Cell::VisualizationState::OPEN_LIST;
       }
-      updatedCells.push_back(neighbor);
+      record(events, neighbor);
     }
 
     // Neighbor is in the closed list.
@@ -169,21 +196,40 @@ std::vector<std::shared_ptr<Grid::Cell>> AStar::step()
     // Neighbor is in the open list and has a higher cost.
     else if (newG < searchData->g) {
       // Update the cost of the neighbor.
+      count().decreaseKey();
       neighborSD->g = newG;
       neighborSD->f = neighborSD->g + neighborSD->h;
-      neighbor->text_bl = std::to_string(neighborSD->g);
-      neighbor->text_br = std::to_string(neighborSD->h);
+      if (annotate) {
+        neighbor->text_bl = std::to_string(neighborSD->g);
+        neighbor->text_br = std::to_string(neighborSD->h);
+      }
       neighborSD->parent = cell;
-      updatedCells.push_back(neighbor);
+      record(events, neighbor);
     }
   }
 
-  return updatedCells;
+  return Status::RUNNING;
 }
 
-std::vector<std::shared_ptr<Grid::Cell>> AStar::path() { return path_; }
+template <bool Visualize>
+std::vector<std::shared_ptr<Grid::Cell>> BasicAStar<Visualize>::path()
+{
+  return path_;
+}
 
-bool AStar::CompareCells::operator()(
+template <bool Visualize>
+bool BasicAStar<Visualize>::pruned(const std::shared_ptr<Cell>& cell) const
+{
+  if (pruning_ == nullptr) {
+    return false;
+  }
+  const int width = grid_->getWidth();
+  return pruning_->pruned(cell->y * width + cell->x,
+      startCell_->y * width + startCell_->x, goalCell_->y * width + goalCell_->x);
+}
+
+template <bool Visualize>
+bool BasicAStar<Visualize>::CompareCells::operator()(
     const std::shared_ptr<Cell> a, const std::shared_ptr<Cell> b) const
 {
   auto aData = (SearchData*)(a->searchData);
@@ -191,4 +237,7 @@ bool AStar::CompareCells::operator()(
 
   return aData->f > bData->f;
 }
+
+template class BasicAStar<true>;
+template class BasicAStar<false>;
 } // namespace SearchAlgorithms
\ No newline at end of file
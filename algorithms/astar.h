@@ -5,14 +5,20 @@
 #include <queue>
 #include <vector>
 
-#include "../global_state.h"
 #include "../grid.h"
-#include "../widgets/graphics_area.h"
+#include "dead_end_pruning.h"
+#include "heuristics.h"
 #include "search_algorithm.h"
 
 namespace SearchAlgorithms {
 
-class AStar : public SearchAlgorithm {
+/**
+ * The A* algorithm.
+ *
+ * \tparam Visualize Whether the search annotates cells and records events for the
+ *                   graphics area. The headless instantiation compiles all of that out.
+ */
+template <bool Visualize> class BasicAStar : public SearchAlgorithm {
 
   public:
 
@@ -28,31 +34,31 @@ class AStar : public SearchAlgorithm {
   };
 
   /**
-   * Construct a new AStar.
+   * Custom comparator for cells.
+   * Both cells must hold SearchData. The cell with the lower f cost comes out of the
+   * open list first.
+   */
+  struct CompareCells {
+    bool operator()(const std::shared_ptr<Grid::Cell> lhs,
+        const std::shared_ptr<Grid::Cell> rhs) const;
+  };
+
+  /**
+   * Construct a new BasicAStar.
    *
    * \param grid The grid to step through.
    * \param start The start cell.
    * \param goal The goal cell.
-   * \param parent The parent object.
-   */
-  AStar(std::shared_ptr<Grid> grid, const std::shared_ptr<Grid::Cell> start,
-      const std::shared_ptr<Grid::Cell> goal);
-
-  /**
-   * Destroy a AStar.
+   * \param pruning Regions of the grid that may be skipped, if any.
    */
-  ~AStar();
+  BasicAStar(std::shared_ptr<Grid> grid, const std::shared_ptr<Grid::Cell> start,
+      const std::shared_ptr<Grid::Cell> goal,
+      std::shared_ptr<const DeadEndPruning> pruning = nullptr);
 
   /**
-   * Step through the AStar algorithm.
-   * Cells will be updated in this function.
-   * A vector of cells that were updated will be returned, so that the graphics area can
-   * update them.
-   * An empty vector will be returned if the algorithm is finished.
-   *
-   * \return A vector of cells that were updated.
+   * Destroy a BasicAStar.
    */
-  std::vector<std::shared_ptr<Grid::Cell>> step();
+  ~BasicAStar();
 
   /**
    * Get the path found by the search algorithm.
@@ -64,6 +70,17 @@ class AStar : public SearchAlgorithm {
    */
   std::vector<std::shared_ptr<Grid::Cell>> path();
 
+  protected:
+
+  /**
+   * Expand the next cell of the AStar algorithm.
+   * Cells will be updated in this function.
+   *
+   * \param events If not null, an event is added to this for every cell that changed.
+   * \return RUNNING if there is more work to do, otherwise FOUND or NO_PATH.
+   */
+  Status expand(CellEventBuffer* events) override;
+
   private:
 
   /*
@@ -74,14 +91,17 @@ class AStar : public SearchAlgorithm {
   std::shared_ptr<Grid::Cell> startCell_; // The start cell.
   std::shared_ptr<Grid::Cell> goalCell_; // The goal cell.
   std::vector<std::shared_ptr<Grid::Cell>> path_; // The path found by the algorithm.
+  std::shared_ptr<const DeadEndPruning> pruning_; // Regions that may be skipped.
 
   /**
-   * Custom comparator for cells.
+   * Check whether a cell lies in a region that the search may skip.
+   *
+   * \param cell The cell to check.
+   * \return True if the cell has been pruned.
    */
-  struct CompareCells {
-    bool operator()(const std::shared_ptr<Grid::Cell> lhs,
-        const std::shared_ptr<Grid::Cell> rhs) const;
-  } compareCells;
+  bool pruned(const std::shared_ptr<Grid::Cell>& cell) const;
+
+  CompareCells compareCells; // Orders the open list.
 
   /*
    * Data.
@@ -94,6 +114,9 @@ class AStar : public SearchAlgorithm {
       CompareCells>
       pQueue; // The queue of cells to visit.
 };
+
+using AStar = BasicAStar<true>; // A* that draws its progress.
+using HeadlessAStar = BasicAStar<false>; // A* that only finds a path.
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,283 @@
+#include "bit_bfs.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using Cell = Grid::Cell;
+
+namespace SearchAlgorithms {
+
+constexpr unsigned int BitBFS::NOT_REACHED;
+
+BitBFS::BitBFS(std::shared_ptr<Grid> grid, const std::shared_ptr<Cell> start,
+    const std::shared_ptr<Cell> goal, std::shared_ptr<const DeadEndPruning> pruning)
+{
+  // Init grid
+  this->grid_ = grid;
+  this->startCell_ = start;
+  this->goalCell_ = goal;
+
+  // If the goal is walled off, fail before building any search state.
+  if (finishIfUnreachable(*grid_, startCell_, goalCell_)) {
+    return;
+  }
+
+  const int width = grid_->getWidth();
+  const int height = grid_->getHeight();
+  stride_ = (width + 63) / 64 + 2;
+  passable_.assign(stride_ * (height + 2), 0);
+  visited_.assign(passable_.size(), 0);
+
+  // Every passable cell costs the same, so any of them gives the step cost.
+  stepCost_ = goal->cost;
+
+  /*
+   * Build the passability mask and make sure that cells do not have any visualization
+   * state left over from previous searches. Pruned regions are simply left out of the
+   * mask, so they cost nothing during the search.
+   */
+
+  const int startIndex = start->y * width + start->x;
+  const int goalIndex = goal->y * width + goal->x;
+
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      auto cell = grid_->getCell(x, y);
+
+      const bool skip = pruning != nullptr
+          && pruning->pruned(y * width + x, startIndex, goalIndex);
+      if (cell->cost != Cell::WALL_COST && !skip) {
+        set(passable_, x, y);
+      }
+
+      // Reset visualization state
+      switch (cell->vis) {
+      case Cell::VisualizationState::PATH:
+      case Cell::VisualizationState::OPEN_LIST:
+      case Cell::VisualizationState::CLOSED_LIST:
+        cell->vis = Cell::VisualizationState::UNVISITED;
+      default:
+        break;
+      }
+    }
+  }
+
+  // The start cell is the first layer, so a goal on the start cell is found at once.
+  frontier_.assign(passable_.size(), 0);
+  next_.assign(passable_.size(), 0);
+  layers_.assign(width * height, NOT_REACHED);
+  set(frontier_, start->x, start->y);
+  set(visited_, start->x, start->y);
+  layers_[startIndex] = 0;
+  found_ = start == goal;
+  count().state(passable_);
+  count().state(visited_);
+  count().state(frontier_);
+  count().state(next_);
+  count().state(layers_);
+  count().push(1);
+}
+
+BitBFS::~BitBFS() { }
+
+bool BitBFS::applicable(const Grid& grid, const std::shared_ptr<Cell> start)
+{
+  unsigned int cost = 0;
+  for (int i = 0; i < grid.getWidth() * grid.getHeight(); i++) {
+    const Cell& cell = *grid.grid[i];
+    if (cell.cost == Cell::WALL_COST || &cell == start.get()) {
+      continue;
+    }
+    if (cost != 0 && cell.cost != cost) {
+      return false;
+    }
+    cost = cell.cost;
+  }
+  return true;
+}
+
+SearchAlgorithm::Status BitBFS::expand(CellEventBuffer* events)
+{
+  // If the goal has been found, the path can be reconstructed.
+  // FOUND will be returned, indicating that the algorithm is finished.
+  if (found_) {
+    if (path_.empty()) {
+      reconstructPath();
+      std::cout << "Path found!" << std::endl;
+    }
+    return Status::FOUND;
+  }
+
+  const int width = grid_->getWidth();
+  const int height = grid_->getHeight();
+  const int words = stride_ - 2;
+
+  /*
+   * A cell is in the next layer if it is passable, has not been visited, and one of its
+   * four neighbors is in the current frontier. Horizontal neighbors are found by
+   * shifting each word by one bit and carrying the edge bit in from the adjacent word.
+   * Vertical neighbors are simply the same word in the rows above and below.
+   *
+   * The padding means that the inner loop has no branches, which lets the compiler
+   * vectorize it.
+   */
+
+  uint64_t any = 0;
+  for (int y = 1; y <= height; y++) {
+    const uint64_t* above = &frontier_[(y - 1) * stride_];
+    const uint64_t* row = &frontier_[y * stride_];
+    const uint64_t* below = &frontier_[(y + 1) * stride_];
+    const uint64_t* passable = &passable_[y * stride_];
+    uint64_t* visited = &visited_[y * stride_];
+    uint64_t* out = &next_[y * stride_];
+
+    for (int k = 1; k <= words; k++) {
+      const uint64_t fromLeft = (row[k] << 1) | (row[k - 1] >> 63);
+      const uint64_t fromRight = (row[k] >> 1) | (row[k + 1] << 63);
+      const uint64_t reached
+          = (fromLeft | fromRight | above[k] | below[k]) & passable[k] & ~visited[k];
+      out[k] = reached;
+      visited[k] |= reached;
+      any |= reached;
+    }
+  }
+
+  // The wavefront died out before reaching the goal.
+  if (any == 0) {
+    if (shown_ != depth_) {
+      showLayers(events);
+    }
+    return Status::NO_PATH; // No path was found
+  }
+
+  // Note the distance of every newly reached cell.
+  depth_++;
+  size_t opened = 0;
+  forEach(next_, [&](int x, int y) {
+    count().push(++opened);
+    layers_[y * width + x] = depth_;
+  });
+
+  // While recording, the previous frontier is now closed and the new one is open.
+  if (events != nullptr && shown_ + 1 == depth_) {
+    const unsigned int distance = depth_ * stepCost_;
+    forEach(frontier_, [&](int x, int y) {
+      const std::shared_ptr<Cell>& cell = grid_->grid[y * width + x];
+      if (cell != startCell_) {
+        cell->vis = Cell::VisualizationState::CLOSED_LIST;
+      }
+      record(events, cell);
+    });
+    forEach(next_, [&](int x, int y) {
+      const std::shared_ptr<Cell>& cell = grid_->grid[y * width + x];
+      if (annotating(events)) {
+        cell->text_tr = std::to_string(distance);
+      }
+      if (cell != goalCell_) {
+        cell->vis = Cell::VisualizationState::OPEN_LIST;
+      }
+      record(events, cell);
+    });
+    shown_ = depth_;
+  }
+
+  frontier_.swap(next_);
+  found_ = test(frontier_, goalCell_->x, goalCell_->y);
+
+  // Catch the visualization up if recording has just started, or the search is over.
+  if ((events != nullptr || found_) && shown_ != depth_) {
+    showLayers(events);
+  }
+
+  return Status::RUNNING;
+}
+
+std::vector<std::shared_ptr<Grid::Cell>> BitBFS::path() { return path_; }
+
+bool BitBFS::test(const Bitset& bits, int x, int y) const
+{
+  const int word = (y + 1) * stride_ + 1 + x / 64;
+  return (bits[word] >> (x % 64)) & 1;
+}
+
+void BitBFS::set(Bitset& bits, int x, int y) const
+{
+  const int word = (y + 1) * stride_ + 1 + x / 64;
+  bits[word] |= (uint64_t)1 << (x % 64);
+}
+
+template <typename F> void BitBFS::forEach(const Bitset& bits, F callback) const
+{
+  // Whole empty words are skipped, so sparse frontiers are cheap to walk.
+  const int words = stride_ - 2;
+  for (int y = 0; y < grid_->getHeight(); y++) {
+    for (int k = 0; k < words; k++) {
+      uint64_t word = bits[(y + 1) * stride_ + 1 + k];
+      for (int bit = 0; word != 0; bit++, word >>= 1) {
+        if (word & 1) {
+          callback(k * 64 + bit, y);
+        }
+      }
+    }
+  }
+}
+
+void BitBFS::showLayers(CellEventBuffer* events)
+{
+  // Cells before the layer that was last shown as open are already closed.
+  for (size_t i = 0; i < layers_.size(); i++) {
+    const unsigned int layer = layers_[i];
+    if (layer == NOT_REACHED || layer < shown_) {
+      continue;
+    }
+    const std::shared_ptr<Cell>& cell = grid_->grid[i];
+    if (layer < depth_ && cell != startCell_) {
+      cell->vis = Cell::VisualizationState::CLOSED_LIST;
+    } else if (layer == depth_ && cell != goalCell_ && cell != startCell_) {
+      cell->vis = Cell::VisualizationState::OPEN_LIST;
+    }
+    if (annotating(events) && layer > 0) {
+      cell->text_tr = std::to_string(layer * stepCost_);
+    }
+    record(events, cell);
+  }
+  shown_ = depth_;
+}
+
+void BitBFS::reconstructPath()
+{
+  /*
+   * The goal is in the last layer. Each cell in layer d was reached from some neighbor
+   * in layer d - 1, so we can walk back to the start one layer at a time. The path is
+   * then reversed so that it starts at the start cell and ends at the goal cell.
+   */
+
+  const int width = grid_->getWidth();
+  const int height = grid_->getHeight();
+  int x = goalCell_->x;
+  int y = goalCell_->y;
+  path_.push_back(goalCell_);
+
+  for (int layer = (int)depth_ - 1; layer >= 0; layer--) {
+    const unsigned int previous = (unsigned int)layer;
+    if (x > 0 && layers_[y * width + x - 1] == previous) {
+      x--;
+    } else if (x < width - 1 && layers_[y * width + x + 1] == previous) {
+      x++;
+    } else if (y > 0 && layers_[(y - 1) * width + x] == previous) {
+      y--;
+    } else if (y < height - 1 && layers_[(y + 1) * width + x] == previous) {
+      y++;
+    }
+
+    auto pathCell = grid_->grid[y * width + x];
+    if (pathCell != startCell_) {
+      pathCell->vis = Cell::VisualizationState::PATH;
+    }
+    path_.push_back(pathCell);
+  }
+
+  std::reverse(path_.begin(), path_.end());
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
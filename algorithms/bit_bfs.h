@@ -0,0 +1,156 @@
+#ifndef BIT_BFS_H
+#define BIT_BFS_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../grid.h"
+#include "dead_end_pruning.h"
+#include "search_algorithm.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * Bit-parallel breadth-first search for grids where every passable cell has the same
+ * cost.
+ *
+ * Each row of the grid is stored as a bitset of 64-bit words. A whole wavefront is
+ * expanded at once by shifting the frontier left, right, up and down and masking it
+ * against the passable cells that have not been visited yet, so 64 cells are handled
+ * per word operation (more where the compiler vectorizes the row loop). The distance
+ * layer of every reached cell is kept so that the path can be walked back from the
+ * goal.
+ *
+ * Cells' visualization states are updated layer by layer only while events are being
+ * recorded. Otherwise they are brought up to date in one pass when the search ends, or
+ * when recording starts again.
+ */
+class BitBFS : public SearchAlgorithm {
+
+  public:
+
+  /**
+   * Construct a new BitBFS.
+   *
+   * \param grid The grid to step through.
+   * \param start The start cell.
+   * \param goal The goal cell.
+   * \param pruning Regions of the grid that may be skipped, if any.
+   */
+  BitBFS(std::shared_ptr<Grid> grid, const std::shared_ptr<Grid::Cell> start,
+      const std::shared_ptr<Grid::Cell> goal,
+      std::shared_ptr<const DeadEndPruning> pruning = nullptr);
+
+  /**
+   * Destroy a BitBFS.
+   */
+  ~BitBFS();
+
+  /**
+   * Check whether a grid can be searched with a BitBFS.
+   * This is the case when every passable cell (other than the start cell, which is
+   * never entered) has the same cost.
+   *
+   * \param grid The grid to check.
+   * \param start The start cell.
+   * \return True if a BFS finds the same paths as Dijkstra's algorithm.
+   */
+  static bool applicable(const Grid& grid, const std::shared_ptr<Grid::Cell> start);
+
+  /**
+   * Get the path found by the search algorithm.
+   * This function should only be called after the algorithm has finished.
+   * An empty vector will be returned if no path was found or the algorithm has not
+   * finished.
+   *
+   * \return A vector of cells that are in the path.
+   */
+  std::vector<std::shared_ptr<Grid::Cell>> path();
+
+  protected:
+
+  /**
+   * Expand the next distance layer of the BFS.
+   *
+   * \param events If not null, an event is added to this for every cell that changed.
+   * \return RUNNING if there is more work to do, otherwise FOUND or NO_PATH.
+   */
+  Status expand(CellEventBuffer* events) override;
+
+  private:
+
+  typedef std::vector<uint64_t> Bitset;
+
+  /**
+   * Get whether a cell is set in a bitset.
+   *
+   * \param bits The bitset.
+   * \param x The x coordinate of the cell.
+   * \param y The y coordinate of the cell.
+   * \return True if the cell is set.
+   */
+  bool test(const Bitset& bits, int x, int y) const;
+
+  /**
+   * Set a cell in a bitset.
+   *
+   * \param bits The bitset.
+   * \param x The x coordinate of the cell.
+   * \param y The y coordinate of the cell.
+   */
+  void set(Bitset& bits, int x, int y) const;
+
+  /**
+   * Call a function for every cell that is set in a bitset.
+   *
+   * \param bits The bitset.
+   * \param callback Called with the x and y coordinates of each set cell.
+   */
+  template <typename F> void forEach(const Bitset& bits, F callback) const;
+
+  /**
+   * Bring the visualization states of the reached cells up to date, by scanning every
+   * cell rather than just the latest layers.
+   *
+   * \param events If not null, an event is added to this for every cell that changed.
+   */
+  void showLayers(CellEventBuffer* events);
+
+  /**
+   * Walk the distance layers back from the goal to build the path.
+   */
+  void reconstructPath();
+
+  /*
+   * Data.
+   */
+
+  std::shared_ptr<Grid> grid_; // The grid to step through.
+  std::shared_ptr<Grid::Cell> startCell_; // The start cell.
+  std::shared_ptr<Grid::Cell> goalCell_; // The goal cell.
+  std::vector<std::shared_ptr<Grid::Cell>> path_; // The path found by the algorithm.
+
+  /*
+   * Bitsets are stored row by row. Each row is padded with an empty word on both sides
+   * and the grid is padded with an empty row above and below, so that shifting across
+   * word and row boundaries never needs a bounds check.
+   */
+
+  static constexpr unsigned int NOT_REACHED = (unsigned int)-1; // Not yet reached.
+
+  int stride_; // The number of words per padded row.
+  unsigned int stepCost_; // The cost of entering any passable cell.
+  bool found_ = false; // Whether the goal has been reached.
+  unsigned int depth_ = 0; // The distance layer of the current frontier.
+  unsigned int shown_ = 0; // The frontier layer that the visualization states show.
+
+  Bitset passable_; // The passable cells.
+  Bitset visited_; // The cells that have been reached.
+  Bitset frontier_; // The cells of the latest distance layer.
+  Bitset next_; // The cells of the layer being expanded into.
+  std::vector<unsigned int> layers_; // The distance layer of each cell, by index.
+};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,151 @@
+#ifndef CELL_EVENTS_H
+#define CELL_EVENTS_H
+
+#include <vector>
+
+#include "../grid.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * A record of a cell changing during a search.
+ */
+struct CellEvent {
+  int index; // The index of the cell in the grid.
+  Grid::Cell::VisualizationState state; // The state the cell was left in.
+};
+
+/**
+ * A reusable buffer of cell events.
+ *
+ * Search algorithms append an event whenever they change a cell, and the graphics area
+ * reads the events back to redraw just those cells. The buffer is meant to be kept and
+ * cleared between ticks rather than rebuilt, so that its storage is only allocated
+ * once.
+ *
+ * The buffer also tells search algorithms whether the cells will be drawn. Annotations
+ * (the numbers in the corners of a cell) are only worth formatting when they are.
+ *
+ * `SearchAlgorithm::run()` marks where each expansion's events end, so that a batch of
+ * events can be split back into expansions (see SearchTrace).
+ */
+class CellEventBuffer {
+  public:
+
+  /**
+   * Construct a new CellEventBuffer.
+   *
+   * \param width The width of the grid the events refer to.
+   */
+  explicit CellEventBuffer(int width = 0)
+      : width_(width)
+      , annotate_(true)
+  {
+  }
+
+  /**
+   * Clear the buffer and point it at a grid of a new width.
+   * The storage is kept.
+   *
+   * \param width The width of the grid the events refer to.
+   */
+  void reset(int width)
+  {
+    width_ = width;
+    clear();
+  }
+
+  /**
+   * Remove every event, keeping the storage.
+   */
+  void clear()
+  {
+    events_.clear();
+    expansionEnds_.clear();
+  }
+
+  /**
+   * Record the current state of a cell.
+   *
+   * \param cell The cell that changed.
+   */
+  void push(const Grid::Cell& cell)
+  {
+    events_.push_back({ cell.y * width_ + cell.x, cell.vis });
+  }
+
+  /**
+   * Append an event that was recorded elsewhere.
+   *
+   * \param event The event to append.
+   */
+  void push(const CellEvent& event) { events_.push_back(event); }
+
+  /**
+   * Mark the end of an expansion's events.
+   */
+  void endExpansion() { expansionEnds_.push_back(events_.size()); }
+
+  /**
+   * Get where each expansion's events end.
+   *
+   * \return The number of events in the buffer at the end of each expansion.
+   */
+  const std::vector<size_t>& expansionEnds() const { return expansionEnds_; }
+
+  /**
+   * Set whether search algorithms should annotate the cells they record.
+   *
+   * \param annotate True if the cells will be drawn with their annotations.
+   */
+  void setAnnotate(bool annotate) { annotate_ = annotate; }
+
+  /**
+   * Check whether search algorithms should annotate the cells they record.
+   *
+   * \return True if the cells will be drawn with their annotations.
+   */
+  bool annotate() const { return annotate_; }
+
+  /**
+   * Get the number of events in the buffer.
+   *
+   * \return The number of events.
+   */
+  size_t size() const { return events_.size(); }
+
+  /**
+   * Check whether the buffer is empty.
+   *
+   * \return True if there are no events.
+   */
+  bool empty() const { return events_.empty(); }
+
+  /**
+   * Get an iterator to the first event.
+   *
+   * \return An iterator to the first event.
+   */
+  std::vector<CellEvent>::const_iterator begin() const { return events_.begin(); }
+
+  /**
+   * Get an iterator past the last event.
+   *
+   * \return An iterator past the last event.
+   */
+  std::vector<CellEvent>::const_iterator end() const { return events_.end(); }
+
+  private:
+
+  /*
+   * Data.
+   */
+
+  int width_; // The width of the grid the events refer to.
+  bool annotate_; // Whether recorded cells should be annotated.
+  std::vector<CellEvent> events_; // The events, in the order they happened.
+  std::vector<size_t> expansionEnds_; // The number of events at each expansion's end.
+};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,335 @@
+#include "dead_end_pruning.h"
+
+#include <algorithm>
+#include <climits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+using Cell = Grid::Cell;
+
+namespace SearchAlgorithms {
+
+DeadEndPruning::DeadEndPruning(const Grid& grid)
+    : width_(grid.getWidth())
+    , height_(grid.getHeight())
+{
+  const int size = width_ * height_;
+  cost_.resize(size);
+  for (int i = 0; i < size; i++) {
+    cost_[i] = grid.grid[i]->cost;
+  }
+  deadEnd_.assign(size, -1);
+  swamp_.assign(size, -1);
+
+  findDeadEnds();
+  findSwamps();
+}
+
+bool DeadEndPruning::pruned(int index, int start, int goal) const
+{
+  const int deadEnd = deadEnd_[index];
+  if (deadEnd != -1 && deadEnd != deadEnd_[start] && deadEnd != deadEnd_[goal]) {
+    return true;
+  }
+  const int swamp = swamp_[index];
+  return swamp != -1 && swamp != swamp_[start] && swamp != swamp_[goal];
+}
+
+bool DeadEndPruning::deadEnd(int index) const { return deadEnd_[index] != -1; }
+
+bool DeadEndPruning::swamp(int index) const { return swamp_[index] != -1; }
+
+void DeadEndPruning::findDeadEnds()
+{
+  const int size = width_ * height_;
+
+  // Get the passable neighbor of a cell in one of four directions, or -1.
+  auto neighbor = [this](int index, int direction) -> int {
+    const int x = index % width_ + (direction == 0 ? -1 : direction == 1 ? 1 : 0);
+    const int y = index / width_ + (direction == 2 ? -1 : direction == 3 ? 1 : 0);
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+      return -1;
+    }
+    const int other = y * width_ + x;
+    return cost_[other] == Cell::WALL_COST ? -1 : other;
+  };
+
+  /*
+   * Tarjan's algorithm splits each connected component into biconnected blocks. It is
+   * run with an explicit stack, since the depth of the search can be as large as the
+   * grid. A cell that ends up in more than one block is an articulation cell, and the
+   * blocks and articulation cells together form the block-cut tree of the component.
+   */
+
+  struct Frame {
+    int cell; // The cell being visited.
+    int direction; // The next direction to try.
+  };
+
+  std::vector<int> discovered(size, -1);
+  std::vector<int> low(size, 0);
+  std::vector<int> parent(size, -1);
+  std::vector<int> cellStack;
+  std::vector<Frame> frames;
+  int time = 0;
+
+  std::vector<std::vector<int>> blocks; // The cells of each block.
+  std::vector<int> cellBlock(size, -1); // The first block that each cell was put in.
+  std::unordered_map<int, std::vector<int>> cutBlocks; // The blocks of each cut cell.
+  std::vector<bool> blockVisited;
+  std::vector<bool> assigned(size, false);
+  int regions = 0;
+
+  for (int root = 0; root < size; root++) {
+    if (cost_[root] == Cell::WALL_COST || discovered[root] != -1) {
+      continue;
+    }
+
+    const size_t firstBlock = blocks.size();
+    discovered[root] = low[root] = time++;
+    cellStack.push_back(root);
+    frames.push_back({ root, 0 });
+
+    while (!frames.empty()) {
+      const int cell = frames.back().cell;
+
+      // Visit the next neighbor of the cell.
+      if (frames.back().direction < 4) {
+        const int next = neighbor(cell, frames.back().direction++);
+        if (next == -1) {
+          continue;
+        }
+        if (discovered[next] == -1) {
+          parent[next] = cell;
+          discovered[next] = low[next] = time++;
+          cellStack.push_back(next);
+          frames.push_back({ next, 0 });
+        } else if (next != parent[cell]) {
+          low[cell] = std::min(low[cell], discovered[next]);
+        }
+        continue;
+      }
+
+      // All neighbors are done, so return to the parent.
+      frames.pop_back();
+      if (frames.empty()) {
+        break;
+      }
+      const int up = frames.back().cell;
+      low[up] = std::min(low[up], low[cell]);
+
+      // If nothing below the cell reaches above the parent, the parent closes a block.
+      if (low[cell] >= discovered[up]) {
+        blocks.emplace_back();
+        std::vector<int>& block = blocks.back();
+        int member;
+        do {
+          member = cellStack.back();
+          cellStack.pop_back();
+          block.push_back(member);
+        } while (member != cell);
+        block.push_back(up);
+
+        const int blockIndex = blocks.size() - 1;
+        for (int blockCell : block) {
+          if (cellBlock[blockCell] == -1) {
+            cellBlock[blockCell] = blockIndex;
+            continue;
+          }
+          std::vector<int>& cellBlocks = cutBlocks[blockCell];
+          if (cellBlocks.empty()) {
+            cellBlocks.push_back(cellBlock[blockCell]);
+          }
+          cellBlocks.push_back(blockIndex);
+        }
+      }
+    }
+    cellStack.clear();
+
+    // An isolated cell has no blocks and nothing to prune.
+    if (firstBlock == blocks.size()) {
+      continue;
+    }
+
+    /*
+     * The largest block is the core of the component. Walking the block-cut tree out
+     * from the core, each block hanging off an articulation cell of the core starts a
+     * new dead-end region, and everything further out belongs to the same region.
+     */
+
+    size_t core = firstBlock;
+    for (size_t b = firstBlock; b < blocks.size(); b++) {
+      if (blocks[b].size() > blocks[core].size()) {
+        core = b;
+      }
+    }
+
+    blockVisited.resize(blocks.size(), false);
+    std::queue<std::pair<int, int>> queue; // Pairs of block and region.
+    queue.push(std::make_pair((int)core, -1));
+    blockVisited[core] = true;
+
+    while (!queue.empty()) {
+      const int block = queue.front().first;
+      const int region = queue.front().second;
+      queue.pop();
+
+      // The articulation cell that leads into a block stays on the parent side.
+      for (int cell : blocks[block]) {
+        if (!assigned[cell]) {
+          assigned[cell] = true;
+          deadEnd_[cell] = region;
+        }
+      }
+
+      for (int cell : blocks[block]) {
+        auto it = cutBlocks.find(cell);
+        if (it == cutBlocks.end()) {
+          continue;
+        }
+        for (int child : it->second) {
+          if (!blockVisited[child]) {
+            blockVisited[child] = true;
+            queue.push(std::make_pair(child, region == -1 ? regions++ : region));
+          }
+        }
+      }
+    }
+  }
+}
+
+void DeadEndPruning::findSwamps()
+{
+  const int size = width_ * height_;
+
+  /*
+   * Cells are checked from a worklist. Removing a cell takes it out of its neighbors'
+   * neighbor pairs, which can make them dominated too, so they are checked again.
+   * Removed cells are marked with -2 until they are labeled with a region.
+   */
+
+  std::vector<int> worklist;
+  std::vector<bool> queued(size, false);
+  for (int i = size - 1; i >= 0; i--) {
+    if (cost_[i] != Cell::WALL_COST) {
+      worklist.push_back(i);
+      queued[i] = true;
+    }
+  }
+
+  while (!worklist.empty()) {
+    const int index = worklist.back();
+    worklist.pop_back();
+    queued[index] = false;
+
+    if (!dominated(index)) {
+      continue;
+    }
+    swamp_[index] = -2;
+
+    const int x = index % width_;
+    const int y = index / width_;
+    const int neighbors[4][2]
+        = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+    for (auto& n : neighbors) {
+      if (open(n[0], n[1]) && !queued[n[1] * width_ + n[0]]) {
+        worklist.push_back(n[1] * width_ + n[0]);
+        queued[n[1] * width_ + n[0]] = true;
+      }
+    }
+  }
+
+  // Label connected swamp cells as regions.
+  int regions = 0;
+  std::vector<int> stack;
+  for (int seed = 0; seed < size; seed++) {
+    if (swamp_[seed] != -2) {
+      continue;
+    }
+    swamp_[seed] = regions;
+    stack.push_back(seed);
+    while (!stack.empty()) {
+      const int index = stack.back();
+      stack.pop_back();
+      const int x = index % width_;
+      const int y = index / width_;
+      const int neighbors[4][2]
+          = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+      for (auto& n : neighbors) {
+        if (n[0] < 0 || n[0] >= width_ || n[1] < 0 || n[1] >= height_) {
+          continue;
+        }
+        const int other = n[1] * width_ + n[0];
+        if (swamp_[other] == -2) {
+          swamp_[other] = regions;
+          stack.push_back(other);
+        }
+      }
+    }
+    regions++;
+  }
+}
+
+bool DeadEndPruning::dominated(int index) const
+{
+  const int x = index % width_;
+  const int y = index / width_;
+
+  /*
+   * The eight cells around the cell form a ring. Any detour between two neighbors that
+   * stays within this 3x3 window has to follow the ring one way or the other. A path
+   * through the cell pays the cost of the cell, while a detour pays the cost of the
+   * ring cells strictly between the two neighbors, so the cell is dominated if one of
+   * the two arcs is strictly cheaper for every pair of neighbors. Cells with fewer than
+   * two neighbors are left for the dead-end analysis.
+   */
+
+  static const int ring[8][2] = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { 1, 0 }, { 1, 1 },
+    { 0, 1 }, { -1, 1 }, { -1, 0 } };
+  const unsigned long long blocked = ULLONG_MAX;
+
+  unsigned long long ringCost[8];
+  int neighbors[4];
+  int neighborCount = 0;
+  for (int k = 0; k < 8; k++) {
+    const int rx = x + ring[k][0];
+    const int ry = y + ring[k][1];
+    ringCost[k] = open(rx, ry) ? cost_[ry * width_ + rx] : blocked;
+    if (k % 2 == 1 && ringCost[k] != blocked) {
+      neighbors[neighborCount++] = k;
+    }
+  }
+  if (neighborCount < 2) {
+    return false;
+  }
+
+  const unsigned long long cost = cost_[index];
+  for (int i = 0; i < neighborCount; i++) {
+    for (int j = i + 1; j < neighborCount; j++) {
+      unsigned long long arcs[2] = { 0, 0 };
+      const int ends[2][2] = { { neighbors[i], neighbors[j] },
+        { neighbors[j], neighbors[i] + 8 } };
+      for (int a = 0; a < 2; a++) {
+        for (int k = ends[a][0] + 1; k < ends[a][1] && arcs[a] != blocked; k++) {
+          arcs[a] = ringCost[k % 8] == blocked ? blocked : arcs[a] + ringCost[k % 8];
+        }
+      }
+      if (std::min(arcs[0], arcs[1]) >= cost) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool DeadEndPruning::open(int x, int y) const
+{
+  if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+    return false;
+  }
+  const int index = y * width_ + x;
+  return cost_[index] != Cell::WALL_COST && swamp_[index] == -1;
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
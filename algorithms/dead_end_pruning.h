@@ -0,0 +1,106 @@
+#ifndef DEAD_END_PRUNING_H
+#define DEAD_END_PRUNING_H
+
+#include <vector>
+
+#include "../grid.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * A preprocessing pass that finds parts of a grid that searches can skip.
+ *
+ * Two kinds of regions are found:
+ *
+ * - Dead ends. The passable cells are split into biconnected blocks, and the largest
+ *   block of each connected component is taken as its core. Everything that hangs off
+ *   the core behind a single articulation cell is a dead-end region, since a path
+ *   between two cells outside the region would have to enter and leave it through the
+ *   same cell.
+ *
+ * - Swamps. A cell is a swamp cell if every pair of its neighbors is joined by a
+ *   strictly cheaper detour around it, so no optimal path can pass through it. Cells
+ *   are removed greedily and their neighbors rechecked, so swamps grow as far as they
+ *   can. Connected swamp cells form a swamp region.
+ *
+ * A region can only be skipped when neither the start nor the goal lies inside it.
+ */
+class DeadEndPruning {
+
+  public:
+
+  /**
+   * Construct a new DeadEndPruning and analyze a grid.
+   *
+   * \param grid The grid to analyze.
+   */
+  DeadEndPruning(const Grid& grid);
+
+  /**
+   * Check whether a search from start to goal may skip a cell.
+   *
+   * \param index The index of the cell.
+   * \param start The index of the start cell.
+   * \param goal The index of the goal cell.
+   * \return True if no optimal path from start to goal passes through the cell.
+   */
+  bool pruned(int index, int start, int goal) const;
+
+  /**
+   * Get whether a cell is part of a dead-end region.
+   *
+   * \param index The index of the cell.
+   * \return True if the cell is in a dead-end region.
+   */
+  bool deadEnd(int index) const;
+
+  /**
+   * Get whether a cell is part of a swamp region.
+   *
+   * \param index The index of the cell.
+   * \return True if the cell is in a swamp region.
+   */
+  bool swamp(int index) const;
+
+  private:
+
+  /**
+   * Find the dead-end regions.
+   */
+  void findDeadEnds();
+
+  /**
+   * Find the swamp regions.
+   */
+  void findSwamps();
+
+  /**
+   * Check whether a cell is strictly dominated by detours around it.
+   *
+   * \param index The index of the cell.
+   * \return True if the cell can be added to a swamp.
+   */
+  bool dominated(int index) const;
+
+  /**
+   * Get whether a cell can be used by a path.
+   *
+   * \param x The x coordinate of the cell.
+   * \param y The y coordinate of the cell.
+   * \return True if the cell is in the grid, is not a wall and is not a swamp cell.
+   */
+  bool open(int x, int y) const;
+
+  /*
+   * Data.
+   */
+
+  int width_; // The width of the grid.
+  int height_; // The height of the grid.
+  std::vector<unsigned int> cost_; // The cost of each cell.
+  std::vector<int> deadEnd_; // The dead-end region of each cell, or -1.
+  std::vector<int> swamp_; // The swamp region of each cell, or -1.
+};
+}
+
+#endif
\ No newline at end of file
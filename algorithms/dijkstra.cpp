@@ -7,14 +7,22 @@ using Cell = Grid::Cell;
 
 namespace SearchAlgorithms {
 
-Dijkstra::Dijkstra(std::shared_ptr<Grid> grid, const std::shared_ptr<Cell> start,
-    const std::shared_ptr<Cell> goal)
+template <bool Visualize>
+BasicDijkstra<Visualize>::BasicDijkstra(std::shared_ptr<Grid> grid,
+    const std::shared_ptr<Cell> start, const std::shared_ptr<Cell> goal,
+    std::shared_ptr<const DeadEndPruning> pruning)
+    : pruning_(pruning)
 {
   // Init grid
   this->grid_ = grid;
   this->startCell_ = start;
   this->goalCell_ = goal;
 
+  // If the goal is walled off, fail before building any search state.
+  if (finishIfUnreachable(*grid_, startCell_, goalCell_)) {
+    return;
+  }
+
   /*
    * Ensure that cells do not have any data left over from previous searches.
    * Search data is cleared and visualization state is reset.
@@ -45,11 +53,14 @@ Dijkstra::Dijkstra(std::shared_ptr<Grid> grid, const std::shared_ptr<Cell> start
 
   // Add start cell to open list
   auto searchData = new SearchData;
+  count().state(sizeof(SearchData));
   startCell_->searchData = searchData;
   pQueue.push(startCell_);
+  count().push(pQueue.size());
 }
 
-Dijkstra::~Dijkstra()
+template <bool Visualize>
+BasicDijkstra<Visualize>::~BasicDijkstra()
 {
   // Clear search data
   for (int x = 0; x < grid_->getWidth(); x++) {
@@ -64,13 +75,19 @@ Dijkstra::~Dijkstra()
   }
 }
 
-std::vector<std::shared_ptr<Grid::Cell>> Dijkstra::step()
+template <bool Visualize>
+SearchAlgorithm::Status BasicDijkstra<Visualize>::expand(CellEventBuffer* events)
 {
-  std::vector<std::shared_ptr<Grid::Cell>> updatedCells;
+  // Without visualization nothing is recorded, so everything that depends on the
+  // event buffer compiles away.
+  if (!Visualize) {
+    events = nullptr;
+  }
+  const bool annotate = annotating(events);
 
   // Check if the open list is empty
   if (pQueue.empty()) {
-    throw NoPathFoundException(); // No path was found
+    return Status::NO_PATH; // No path was found
   }
 
   // Get the cell with the lowest cost
@@ -80,7 +97,7 @@ std::vector<std::shared_ptr<Grid::Cell>> Dijkstra::step()
   auto searchData = (SearchData*)(cell->searchData);
 
   // If the goal has been found, the path can be reconstructed.
-  // An empty vector will be returned, indicating that the algorithm is finished.
+  // FOUND will be returned, indicating that the algorithm is finished.
   if (cell == goalCell_) {
 
     /*
@@ -104,7 +121,7 @@ std::vector<std::shared_ptr<Grid::Cell>> Dijkstra::step()
 
     std::cout << "Path found!" << std::endl;
 
-    return updatedCells;
+    return Status::FOUND;
   }
 
   // Remove the cell from the open list.
@@ -115,7 +132,7 @@ std::vector<std::shared_ptr<Grid::Cell>> Dijkstra::step()
   if (cell != startCell_) {
     cell->vis = Cell::VisualizationState::CLOSED_LIST;
   }
-  updatedCells.push_back(cell);
+  record(events, cell);
 
   // Get the neighbors of the cell.
   std::vector<std::shared_ptr<Grid::Cell>> neighbors = grid_->getNeighbors(cell);
@@ -133,12 +150,18 @@ std::vector<std::shared_ptr<Grid::Cell>> Dijkstra::step()
    */
 
   for (auto neighbor : neighbors) {
+    // Dead ends and swamps cannot be on an optimal path, so they are never opened.
+    if (pruned(neighbor)) {
+      continue;
+    }
+
     auto neighborSD = (SearchData*)(neighbor->searchData);
     unsigned int newCost = searchData->cost + neighbor->cost;
 
     // Neighbor is unvisited.
     if (neighborSD == nullptr) {
       neighborSD = new SearchData;
+      count().state(sizeof(SearchData));
 
       // If the neighbor is a wall, it is added to the closed list.
       if (neighbor->cost == Cell::WALL_COST) {
@@ -146,15 +169,18 @@ std::vector<std::shared_ptr<Grid::Cell>> Dijkstra::step()
         continue;
       }
 
-      neighbor->text_tr = std::to_string(newCost);
+      if (annotate) {
+        neighbor->text_tr = std::to_string(newCost);
+      }
       neighborSD->cost = newCost;
       neighborSD->parent = cell;
       neighbor->searchData = neighborSD;
       pQueue.push(neighbor);
+      count().push(pQueue.size());
       if (neighbor != goalCell_) {
         neighbor->vis = Cell::VisualizationState::OPEN_LIST;
       }
-      updatedCells.push_back(neighbor);
+      record(events, neighbor);
     }
 
     // Neighbor is in the closed list.
@@ -165,19 +191,38 @@ std::vector<std::shared_ptr<Grid::Cell>> Dijkstra::step()
     // Neighbor is in the open list and has a higher cost.
     else if (newCost < searchData->cost) {
       // Update the cost of the neighbor.
-      neighbor->text_tr = std::to_string(newCost);
+      count().decreaseKey();
+      if (annotate) {
+        neighbor->text_tr = std::to_string(newCost);
+      }
       neighborSD->cost = newCost;
       neighborSD->parent = cell;
-      updatedCells.push_back(neighbor);
+      record(events, neighbor);
     }
   }
 
-  return updatedCells;
+  return Status::RUNNING;
 }
 
-std::vector<std::shared_ptr<Grid::Cell>> Dijkstra::path() { return path_; }
+template <bool Visualize>
+std::vector<std::shared_ptr<Grid::Cell>> BasicDijkstra<Visualize>::path()
+{
+  return path_;
+}
 
-bool Dijkstra::CompareCells::operator()(
+template <bool Visualize>
+bool BasicDijkstra<Visualize>::pruned(const std::shared_ptr<Cell>& cell) const
+{
+  if (pruning_ == nullptr) {
+    return false;
+  }
+  const int width = grid_->getWidth();
+  return pruning_->pruned(cell->y * width + cell->x,
+      startCell_->y * width + startCell_->x, goalCell_->y * width + goalCell_->x);
+}
+
+template <bool Visualize>
+bool BasicDijkstra<Visualize>::CompareCells::operator()(
     const std::shared_ptr<Cell> a, const std::shared_ptr<Cell> b) const
 {
   auto aData = (SearchData*)(a->searchData);
@@ -185,4 +230,7 @@ bool Dijkstra::CompareCells::operator()(
 
   return aData->cost > bData->cost;
 }
+
+template class BasicDijkstra<true>;
+template class BasicDijkstra<false>;
 } // namespace SearchAlgorithms
\ No newline at end of file
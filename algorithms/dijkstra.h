@@ -5,14 +5,19 @@
 #include <queue>
 #include <vector>
 
-#include "../global_state.h"
 #include "../grid.h"
-#include "../widgets/graphics_area.h"
+#include "dead_end_pruning.h"
 #include "search_algorithm.h"
 
 namespace SearchAlgorithms {
 
-class Dijkstra : public SearchAlgorithm {
+/**
+ * Dijkstra's algorithm.
+ *
+ * \tparam Visualize Whether the search annotates cells and records events for the
+ *                   graphics area. The headless instantiation compiles all of that out.
+ */
+template <bool Visualize> class BasicDijkstra : public SearchAlgorithm {
 
   public:
 
@@ -26,31 +31,21 @@ class Dijkstra : public SearchAlgorithm {
   };
 
   /**
-   * Construct a new Dijkstra.
+   * Construct a new BasicDijkstra.
    *
    * \param grid The grid to step through.
    * \param start The start cell.
    * \param goal The goal cell.
-   * \param parent The parent object.
+   * \param pruning Regions of the grid that may be skipped, if any.
    */
-  Dijkstra(std::shared_ptr<Grid> grid, const std::shared_ptr<Grid::Cell> start,
-      const std::shared_ptr<Grid::Cell> goal);
+  BasicDijkstra(std::shared_ptr<Grid> grid, const std::shared_ptr<Grid::Cell> start,
+      const std::shared_ptr<Grid::Cell> goal,
+      std::shared_ptr<const DeadEndPruning> pruning = nullptr);
 
   /**
-   * Destroy a Dijkstra.
+   * Destroy a BasicDijkstra.
    */
-  ~Dijkstra();
-
-  /**
-   * Step through the Dijkstra algorithm.
-   * Cells will be updated in this function.
-   * A vector of cells that were updated will be returned, so that the graphics area can
-   * update them.
-   * An empty vector will be returned if the algorithm is finished.
-   *
-   * \return A vector of cells that were updated.
-   */
-  std::vector<std::shared_ptr<Grid::Cell>> step();
+  ~BasicDijkstra();
 
   /**
    * Get the path found by the search algorithm.
@@ -62,6 +57,17 @@ class Dijkstra : public SearchAlgorithm {
    */
   std::vector<std::shared_ptr<Grid::Cell>> path();
 
+  protected:
+
+  /**
+   * Expand the next cell of the Dijkstra algorithm.
+   * Cells will be updated in this function.
+   *
+   * \param events If not null, an event is added to this for every cell that changed.
+   * \return RUNNING if there is more work to do, otherwise FOUND or NO_PATH.
+   */
+  Status expand(CellEventBuffer* events) override;
+
   private:
 
   /*
@@ -72,6 +78,15 @@ class Dijkstra : public SearchAlgorithm {
   std::shared_ptr<Grid::Cell> startCell_; // The start cell.
   std::shared_ptr<Grid::Cell> goalCell_; // The goal cell.
   std::vector<std::shared_ptr<Grid::Cell>> path_; // The path found by the algorithm.
+  std::shared_ptr<const DeadEndPruning> pruning_; // Regions that may be skipped.
+
+  /**
+   * Check whether a cell lies in a region that the search may skip.
+   *
+   * \param cell The cell to check.
+   * \return True if the cell has been pruned.
+   */
+  bool pruned(const std::shared_ptr<Grid::Cell>& cell) const;
 
   /**
    * Custom comparator for cells.
@@ -92,6 +107,9 @@ class Dijkstra : public SearchAlgorithm {
       CompareCells>
       pQueue; // The queue of cells to visit.
 };
+
+using Dijkstra = BasicDijkstra<true>; // Dijkstra that draws its progress.
+using HeadlessDijkstra = BasicDijkstra<false>; // Dijkstra that only finds a path.
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "engine_table.h"
+
+#include <mutex>
+
+#include "astar.h"
+#include "bit_bfs.h"
+#include "dijkstra.h"
+#include "fringe_search.h"
+#include "hda_star.h"
+#include "subgoal_graph.h"
+#include "subgoal_search.h"
+#include "theta_star.h"
+
+namespace SearchAlgorithms {
+
+using GridPointer = std::shared_ptr<Grid>;
+using CellPointer = std::shared_ptr<Grid::Cell>;
+using EnginePointer = std::shared_ptr<SearchAlgorithm>;
+
+namespace {
+
+/**
+ * A subgoal graph shared by the searches of one engine table.
+ */
+struct SharedGraph {
+  std::mutex mutex; // Guards `graph`.
+  std::shared_ptr<SubgoalGraph> graph; // The graph, once it has been built.
+};
+}
+
+std::vector<NamedEngine> engineTable()
+{
+  std::shared_ptr<SharedGraph> shared = std::make_shared<SharedGraph>();
+
+  return {
+    { "astar",
+        [](GridPointer grid, CellPointer start, CellPointer goal,
+            bool visualize) -> EnginePointer {
+          if (visualize) {
+            return std::make_shared<AStar>(grid, start, goal);
+          }
+          return std::make_shared<HeadlessAStar>(grid, start, goal);
+        } },
+    { "dijkstra",
+        [](GridPointer grid, CellPointer start, CellPointer goal,
+            bool visualize) -> EnginePointer {
+          if (visualize) {
+            return std::make_shared<Dijkstra>(grid, start, goal);
+          }
+          return std::make_shared<HeadlessDijkstra>(grid, start, goal);
+        } },
+    { "bitbfs",
+        [](GridPointer grid, CellPointer start, CellPointer goal,
+            bool) -> EnginePointer {
+          if (!BitBFS::applicable(*grid, start)) {
+            return nullptr;
+          }
+          return std::make_shared<BitBFS>(grid, start, goal);
+        } },
+    { "fringe",
+        [](GridPointer grid, CellPointer start, CellPointer goal,
+            bool) -> EnginePointer {
+          return std::make_shared<FringeSearch>(grid, start, goal);
+        } },
+    { "hda",
+        [](GridPointer grid, CellPointer start, CellPointer goal,
+            bool) -> EnginePointer {
+          return std::make_shared<HDAStar>(grid, start, goal);
+        } },
+    { "subgoal",
+        [shared](GridPointer grid, CellPointer start, CellPointer goal,
+            bool) -> EnginePointer {
+          std::shared_ptr<SubgoalGraph> graph;
+          {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            if (shared->graph == nullptr) {
+              shared->graph = std::make_shared<SubgoalGraph>(*grid);
+            }
+            graph = shared->graph;
+          }
+          return std::make_shared<SubgoalSearch>(grid, start, goal, graph);
+        } },
+    { "theta",
+        [](GridPointer grid, CellPointer start, CellPointer goal,
+            bool) -> EnginePointer {
+          return std::make_shared<ThetaStar>(grid, start, goal);
+        } },
+    { "lazy-theta",
+        [](GridPointer grid, CellPointer start, CellPointer goal,
+            bool) -> EnginePointer {
+          return std::make_shared<ThetaStar>(grid, start, goal, true);
+        } },
+  };
+}
+
+double pathCost(const std::vector<std::shared_ptr<Grid::Cell>>& path)
+{
+  double cost = 0;
+  for (size_t i = 1; i < path.size(); i++) {
+    cost += path[i]->cost;
+  }
+  return cost;
+}
+}
\ No newline at end of file
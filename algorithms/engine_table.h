@@ -0,0 +1,50 @@
+#ifndef ENGINE_TABLE_H
+#define ENGINE_TABLE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../grid.h"
+#include "search_algorithm.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * Creates an engine searching a grid, or returns nullptr if the engine can't search
+ * it. The engine records cell events only if `visualize` is set.
+ */
+using EngineFactory = std::function<std::shared_ptr<SearchAlgorithm>(
+    std::shared_ptr<Grid> grid, std::shared_ptr<Grid::Cell> start,
+    std::shared_ptr<Grid::Cell> goal, bool visualize)>;
+
+/**
+ * An engine that the tools can run by name.
+ */
+struct NamedEngine {
+  std::string name; // The name of the engine on the command line.
+  EngineFactory create; // Creates the engine.
+};
+
+/**
+ * Get every engine, by name.
+ *
+ * The factories of one table may be called from many threads at once, each on its own
+ * copy of the same map: the subgoal graph, which only depends on the walls, is built
+ * from the first grid searched and shared by every later search.
+ *
+ * \return The engines.
+ */
+std::vector<NamedEngine> engineTable();
+
+/**
+ * Get the cost of a path, which is the cost of every cell entered along it.
+ *
+ * \param path The path.
+ * \return The cost of the path.
+ */
+double pathCost(const std::vector<std::shared_ptr<Grid::Cell>>& path);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "find_path.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "../profiler.h"
+#include "heuristics.h"
+
+using Cell = Grid::Cell;
+
+namespace SearchAlgorithms {
+
+FindPathResult findPath(const Grid& grid, const std::shared_ptr<Cell>& start,
+    const std::shared_ptr<Cell>& goal, const FindPathOptions& options)
+{
+  PROFILE_SCOPE("findPath");
+  auto begin = std::chrono::steady_clock::now();
+
+  FindPathResult result;
+  const int width = grid.getWidth();
+  const int height = grid.getHeight();
+  const int startIndex = start->y * width + start->x;
+  const int goalIndex = goal->y * width + goal->x;
+  const bool informed = options.engine == FindPathOptions::Engine::ASTAR;
+
+  /*
+   * The open list holds (f, cell) pairs. A cell whose g drops while it is open is
+   * pushed again rather than updated in place, and the out-of-date entry is skipped
+   * when it comes out.
+   */
+
+  using Entry = std::pair<unsigned int, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  std::vector<unsigned int> g(width * height, UINT_MAX); // The cost to each cell.
+  std::vector<int> parent(width * height, -1); // The cell each cell was reached from.
+  std::vector<bool> closed(width * height, false); // Whether each cell is expanded.
+  SearchCounters& counters = result.counters;
+  counters.state(g);
+  counters.state(parent);
+  counters.state(closed);
+
+  auto heuristic = [&](int index) {
+    return informed
+        ? Heuristics::manhattan(index % width, index / width, goal->x, goal->y)
+        : 0;
+  };
+
+  if (start->cost != Cell::WALL_COST && goal->cost != Cell::WALL_COST) {
+    g[startIndex] = 0;
+    open.push(Entry(heuristic(startIndex), startIndex));
+    counters.push(open.size());
+  }
+
+  while (!open.empty()) {
+    const int index = open.top().second;
+    open.pop();
+    if (closed[index]) {
+      counters.stalePop();
+      continue;
+    }
+
+    // Rebuild the path from the parents once the goal comes out of the open list.
+    if (index == goalIndex) {
+      for (int cell = goalIndex; cell != -1; cell = parent[cell]) {
+        result.path.push_back(grid.grid[cell]);
+      }
+      std::reverse(result.path.begin(), result.path.end());
+      result.cost = g[goalIndex];
+      result.status = SearchAlgorithm::Status::FOUND;
+      break;
+    }
+    if (options.maxExpansions != 0 && counters.expansions >= options.maxExpansions) {
+      result.status = SearchAlgorithm::Status::RUNNING;
+      break;
+    }
+
+    // Expand the cell, visiting its neighbors in the same order as the grid does.
+    closed[index] = true;
+    counters.expansions++;
+    const int x = index % width;
+    const int y = index / width;
+    const int neighbors[] = { x > 0 ? index - 1 : -1, x < width - 1 ? index + 1 : -1,
+      y > 0 ? index - width : -1, y < height - 1 ? index + width : -1 };
+    for (int neighbor : neighbors) {
+      if (neighbor == -1 || closed[neighbor]) {
+        continue;
+      }
+      const unsigned int cost = grid.grid[neighbor]->cost;
+      if (cost == Cell::WALL_COST) {
+        continue;
+      }
+      const unsigned int newG = g[index] + cost;
+      if (newG >= g[neighbor]) {
+        continue;
+      }
+      if (g[neighbor] != UINT_MAX) {
+        counters.decreaseKey();
+      }
+      g[neighbor] = newG;
+      parent[neighbor] = index;
+      open.push(Entry(newG + heuristic(neighbor), neighbor));
+      counters.push(open.size());
+    }
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  counters.milliseconds
+      = std::chrono::duration<double, std::milli>(end - begin).count();
+  return result;
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef FIND_PATH_H
+#define FIND_PATH_H
+
+#include <memory>
+#include <vector>
+
+#include "../grid.h"
+#include "search_algorithm.h"
+#include "search_counters.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * Options for `findPath()`.
+ */
+struct FindPathOptions {
+
+  /**
+   * A search to run.
+   */
+  enum class Engine {
+    DIJKSTRA, // Dijkstra's algorithm.
+    ASTAR // A* with the Manhattan heuristic.
+  };
+
+  Engine engine = Engine::ASTAR; // The search to run.
+  unsigned long maxExpansions = 0; // The most expansions to do (0 for no limit).
+};
+
+/**
+ * The outcome of `findPath()`.
+ */
+struct FindPathResult {
+  SearchAlgorithm::Status status
+      = SearchAlgorithm::Status::NO_PATH; // RUNNING if the expansions ran out.
+  std::vector<std::shared_ptr<Grid::Cell>> path; // The cells from start to goal.
+  unsigned int cost = 0; // The cost of the path: the costs of the cells it enters.
+  SearchCounters counters; // What the search did, including its time.
+};
+
+/**
+ * Find a path between two cells, without touching the grid.
+ *
+ * Unlike the engines, which keep their state in the cells and update the cells'
+ * visualization states and annotations as they go, this keeps its state in vectors
+ * indexed by cell and only ever reads the cells' costs. That makes it cheaper than a
+ * headless engine, and safe to call from many threads at once on a grid that isn't
+ * being edited. An unreachable goal is found by searching everything reachable from the
+ * start, since the grid's connected components can't be queried without updating them.
+ *
+ * The paths found are the same length as those of the Dijkstra and A* engines, but ties
+ * may be broken differently.
+ *
+ * \param grid The grid to search.
+ * \param start The start cell.
+ * \param goal The goal cell.
+ * \param options How to search.
+ * \return The path found, if any, and what the search did.
+ */
+FindPathResult findPath(const Grid& grid, const std::shared_ptr<Grid::Cell>& start,
+    const std::shared_ptr<Grid::Cell>& goal,
+    const FindPathOptions& options = FindPathOptions());
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "fringe_search.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <string>
+
+using Cell = Grid::Cell;
+
+namespace SearchAlgorithms {
+
+FringeSearch::FringeSearch(std::shared_ptr<Grid> grid,
+    const std::shared_ptr<Cell> start, const std::shared_ptr<Cell> goal,
+    std::shared_ptr<const DeadEndPruning> pruning)
+    : pruning_(pruning)
+{
+  // Init grid
+  this->grid_ = grid;
+  this->startCell_ = start;
+  this->goalCell_ = goal;
+  width_ = grid_->getWidth();
+  startIndex_ = start->y * width_ + start->x;
+  goalIndex_ = goal->y * width_ + goal->x;
+
+  // If the goal is walled off, fail before building any search state.
+  if (finishIfUnreachable(*grid_, startCell_, goalCell_)) {
+    return;
+  }
+
+  /*
+   * Search state is kept in flat arrays indexed by cell, so that walking the lists and
+   * looking at neighbors touches contiguous memory instead of chasing pointers. Pruned
+   * cells are treated as walls.
+   */
+
+  const int size = width_ * grid_->getHeight();
+  cost_.resize(size);
+  for (int i = 0; i < size; i++) {
+    auto cell = grid_->grid[i];
+    cost_[i] = cell->cost;
+    if (pruning_ != nullptr && pruning_->pruned(i, startIndex_, goalIndex_)) {
+      cost_[i] = Cell::WALL_COST;
+    }
+
+    // Reset visualization state
+    switch (cell->vis) {
+    case Cell::VisualizationState::PATH:
+    case Cell::VisualizationState::OPEN_LIST:
+    case Cell::VisualizationState::CLOSED_LIST:
+      cell->vis = Cell::VisualizationState::UNVISITED;
+    default:
+      break;
+    }
+  }
+  g_.assign(size, UINT_MAX);
+  parent_.assign(size, -1);
+  next_.assign(size, -1);
+  prev_.assign(size, -1);
+  list_.assign(size, -1);
+  count().state(cost_);
+  count().state(g_);
+  count().state(parent_);
+  count().state(next_);
+  count().state(prev_);
+  count().state(list_);
+  head_[0] = head_[1] = -1;
+  tail_[0] = tail_[1] = -1;
+
+  // Start with only the start cell in `now`.
+  g_[startIndex_] = 0;
+  threshold_ = heuristic(startIndex_);
+  nextThreshold_ = UINT_MAX;
+  insert(now_, startIndex_, true);
+  count().push(listed_);
+}
+
+FringeSearch::~FringeSearch() { }
+
+SearchAlgorithm::Status FringeSearch::expand(CellEventBuffer* events)
+{
+  while (true) {
+
+    // Once `now` runs out, raise the threshold and start on `later`.
+    if (head_[now_] == -1) {
+      if (head_[now_ ^ 1] == -1) {
+        return Status::NO_PATH; // No path was found
+      }
+      threshold_ = nextThreshold_;
+      nextThreshold_ = UINT_MAX;
+      now_ ^= 1;
+      iterations_++;
+      continue;
+    }
+
+    // Defer the cell if it is over the threshold.
+    const int index = head_[now_];
+    const unsigned int f = g_[index] + heuristic(index);
+    if (f > threshold_) {
+      remove(index);
+      insert(now_ ^ 1, index, false);
+      nextThreshold_ = std::min(nextThreshold_, f);
+      continue;
+    }
+    remove(index);
+
+    // If the goal has been found, the path can be reconstructed.
+    // FOUND will be returned, indicating that the algorithm is finished.
+    if (index == goalIndex_) {
+      for (int i = goalIndex_; i != -1; i = parent_[i]) {
+        auto pathCell = grid_->grid[i];
+        if (pathCell != startCell_ && pathCell != goalCell_) {
+          pathCell->vis = Cell::VisualizationState::PATH;
+        }
+        path_.push_back(pathCell);
+      }
+      std::reverse(path_.begin(), path_.end());
+
+      std::cout << "Path found!" << std::endl;
+      return Status::FOUND;
+    }
+
+    // Expand the cell.
+    auto cell = grid_->grid[index];
+    if (cell != startCell_) {
+      cell->vis = Cell::VisualizationState::CLOSED_LIST;
+    }
+    record(events, cell);
+
+    /*
+     * Each neighbor that is reached more cheaply than before is unlinked from whichever
+     * list it was in (or reopened, if it had already been expanded) and put at the
+     * front of `now`, so that it is looked at next.
+     */
+
+    const int x = index % width_;
+    const int y = index / width_;
+    const int neighbors[4][2]
+        = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+    for (auto& n : neighbors) {
+      if (n[0] < 0 || n[0] >= width_ || n[1] < 0 || n[1] >= grid_->getHeight()) {
+        continue;
+      }
+      const int neighbor = n[1] * width_ + n[0];
+      if (cost_[neighbor] == Cell::WALL_COST) {
+        continue;
+      }
+      const unsigned int newG = g_[index] + cost_[neighbor];
+      if (newG >= g_[neighbor]) {
+        continue;
+      }
+      if (list_[neighbor] != -1) {
+        count().decreaseKey();
+      }
+      g_[neighbor] = newG;
+      parent_[neighbor] = index;
+      remove(neighbor);
+      insert(now_, neighbor, true);
+      count().push(listed_);
+
+      auto neighborCell = grid_->grid[neighbor];
+      if (annotating(events)) {
+        const unsigned int h = heuristic(neighbor);
+        neighborCell->text_tr = std::to_string(newG + h);
+        neighborCell->text_bl = std::to_string(newG);
+        neighborCell->text_br = std::to_string(h);
+      }
+      if (neighborCell != goalCell_ && neighborCell != startCell_) {
+        neighborCell->vis = Cell::VisualizationState::OPEN_LIST;
+      }
+      record(events, neighborCell);
+    }
+    return Status::RUNNING;
+  }
+}
+
+std::vector<std::shared_ptr<Grid::Cell>> FringeSearch::path() { return path_; }
+
+unsigned long FringeSearch::iterations() const { return iterations_; }
+
+unsigned int FringeSearch::heuristic(int index) const
+{
+  return Heuristics::manhattan(
+      index % width_, index / width_, goalCell_->x, goalCell_->y);
+}
+
+void FringeSearch::insert(int list, int index, bool front)
+{
+  list_[index] = list;
+  listed_++;
+  if (head_[list] == -1) {
+    prev_[index] = next_[index] = -1;
+    head_[list] = tail_[list] = index;
+  } else if (front) {
+    prev_[index] = -1;
+    next_[index] = head_[list];
+    prev_[head_[list]] = index;
+    head_[list] = index;
+  } else {
+    prev_[index] = tail_[list];
+    next_[index] = -1;
+    next_[tail_[list]] = index;
+    tail_[list] = index;
+  }
+}
+
+void FringeSearch::remove(int index)
+{
+  const int list = list_[index];
+  if (list == -1) {
+    return;
+  }
+  if (prev_[index] == -1) {
+    head_[list] = next_[index];
+  } else {
+    next_[prev_[index]] = next_[index];
+  }
+  if (next_[index] == -1) {
+    tail_[list] = prev_[index];
+  } else {
+    prev_[next_[index]] = prev_[index];
+  }
+  list_[index] = -1;
+  listed_--;
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
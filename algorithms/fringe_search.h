@@ -0,0 +1,139 @@
+#ifndef FRINGE_SEARCH_H
+#define FRINGE_SEARCH_H
+
+#include <memory>
+#include <vector>
+
+#include "../grid.h"
+#include "dead_end_pruning.h"
+#include "heuristics.h"
+#include "search_algorithm.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * Fringe Search.
+ *
+ * Fringe Search gives the same results as A* without a priority queue. The fringe is
+ * kept in two linked lists threaded through arrays indexed by cell: `now` holds cells
+ * whose f-cost is within the current threshold, and `later` holds the rest. Cells are
+ * taken from the front of `now`. Cells over the threshold are moved to `later`, while
+ * cells within it are expanded and their children put at the front of `now`. Once `now`
+ * runs out, the threshold is raised to the cheapest f-cost in `later` and the two lists
+ * swap roles.
+ *
+ * The heuristic is the same one that AStar uses, so the two can be compared directly.
+ */
+class FringeSearch : public SearchAlgorithm {
+
+  public:
+
+  /**
+   * Construct a new FringeSearch.
+   *
+   * \param grid The grid to step through.
+   * \param start The start cell.
+   * \param goal The goal cell.
+   * \param pruning Regions of the grid that may be skipped, if any.
+   */
+  FringeSearch(std::shared_ptr<Grid> grid, const std::shared_ptr<Grid::Cell> start,
+      const std::shared_ptr<Grid::Cell> goal,
+      std::shared_ptr<const DeadEndPruning> pruning = nullptr);
+
+  /**
+   * Destroy a FringeSearch.
+   */
+  ~FringeSearch();
+
+  /**
+   * Get the path found by the search algorithm.
+   * This function should only be called after the algorithm has finished.
+   * An empty vector will be returned if no path was found or the algorithm has not
+   * finished.
+   *
+   * \return A vector of cells that are in the path.
+   */
+  std::vector<std::shared_ptr<Grid::Cell>> path();
+
+  /**
+   * Get the number of times the threshold has been raised so far.
+   *
+   * \return The number of threshold iterations.
+   */
+  unsigned long iterations() const;
+
+  protected:
+
+  /**
+   * Expand the next cell of the Fringe Search, moving any cells over the threshold to
+   * `later` on the way.
+   *
+   * \param events If not null, an event is added to this for every cell that changed.
+   * \return RUNNING if there is more work to do, otherwise FOUND or NO_PATH.
+   */
+  Status expand(CellEventBuffer* events) override;
+
+  private:
+
+  /**
+   * Get the heuristic cost from a cell to the goal.
+   *
+   * \param index The index of the cell.
+   * \return The heuristic cost.
+   */
+  unsigned int heuristic(int index) const;
+
+  /**
+   * Add a cell to the front or back of a list.
+   *
+   * \param list The list (0 or 1).
+   * \param index The index of the cell, which must not be in a list.
+   * \param front True to add the cell at the front, false to add it at the back.
+   */
+  void insert(int list, int index, bool front);
+
+  /**
+   * Remove a cell from the list that it is in, if any.
+   *
+   * \param index The index of the cell.
+   */
+  void remove(int index);
+
+  /*
+   * Data.
+   */
+
+  std::shared_ptr<Grid> grid_; // The grid to step through.
+  std::shared_ptr<Grid::Cell> startCell_; // The start cell.
+  std::shared_ptr<Grid::Cell> goalCell_; // The goal cell.
+  std::vector<std::shared_ptr<Grid::Cell>> path_; // The path found by the algorithm.
+  std::shared_ptr<const DeadEndPruning> pruning_; // Regions that may be skipped.
+
+  int width_; // The width of the grid.
+  int startIndex_; // The index of the start cell.
+  int goalIndex_; // The index of the goal cell.
+
+  std::vector<unsigned int> cost_; // A snapshot of the cell costs.
+  std::vector<unsigned int> g_; // The cost to get to each cell.
+  std::vector<int> parent_; // The parent of each cell, or -1.
+
+  /*
+   * The two lists are doubly linked through `next_` and `prev_`, so a cell can be
+   * unlinked in constant time when a cheaper path to it is found.
+   */
+
+  std::vector<int> next_; // The next cell in the same list, or -1.
+  std::vector<int> prev_; // The previous cell in the same list, or -1.
+  std::vector<signed char> list_; // The list that each cell is in, or -1.
+  int head_[2]; // The first cell of each list, or -1.
+  int tail_[2]; // The last cell of each list, or -1.
+  int now_ = 0; // Which of the two lists is currently `now`.
+  size_t listed_ = 0; // The number of cells in either list.
+
+  unsigned int threshold_; // The current f-cost threshold.
+  unsigned int nextThreshold_; // The cheapest f-cost that was over the threshold.
+  unsigned long iterations_ = 0; // The number of times the threshold was raised.
+};
+}
+
+#endif
\ No newline at end of file
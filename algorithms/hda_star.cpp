@@ -0,0 +1,341 @@
+#include "hda_star.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <thread>
+
+using Cell = Grid::Cell;
+
+namespace {
+
+constexpr unsigned long STOP_CHECK_INTERVAL
+    = 256; // The worker iterations between checks for the run stopping.
+}
+
+namespace SearchAlgorithms {
+
+HDAStar::HDAStar(std::shared_ptr<Grid> grid, const std::shared_ptr<Cell> start,
+    const std::shared_ptr<Cell> goal, unsigned int threadCount)
+    : incumbent_(UINT_MAX)
+    , outstanding_(0)
+{
+  // Init grid
+  this->grid_ = grid;
+  this->startCell_ = start;
+  this->goalCell_ = goal;
+  width_ = grid_->getWidth();
+  startIndex_ = start->y * width_ + start->x;
+  goalIndex_ = goal->y * width_ + goal->x;
+
+  // If the goal is walled off, fail before building any search state.
+  if (finishIfUnreachable(*grid_, startCell_, goalCell_)) {
+    return;
+  }
+
+  // Use every core unless told otherwise.
+  threadCount_ = threadCount;
+  if (threadCount_ == 0) {
+    threadCount_ = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  /*
+   * The workers never touch the cells themselves. Costs are copied into a flat array
+   * so that they can be read from any thread, and search state is kept in flat arrays
+   * indexed by cell. Each cell is only ever written by the worker that owns it.
+   */
+
+  const int size = width_ * grid_->getHeight();
+  cost_.resize(size);
+  for (int i = 0; i < size; i++) {
+    auto cell = grid_->grid[i];
+    cost_[i] = cell->cost;
+
+    // Reset visualization state
+    switch (cell->vis) {
+    case Cell::VisualizationState::PATH:
+    case Cell::VisualizationState::OPEN_LIST:
+    case Cell::VisualizationState::CLOSED_LIST:
+      cell->vis = Cell::VisualizationState::UNVISITED;
+    default:
+      break;
+    }
+  }
+  g_.assign(size, UINT_MAX);
+  parent_.assign(size, -1);
+  expandedBy_.assign(size, -1);
+  count().state(cost_);
+  count().state(g_);
+  count().state(parent_);
+  count().state(expandedBy_);
+
+  for (unsigned int i = 0; i < threadCount_; i++) {
+    inboxes_.emplace_back(new MpscQueue<Message>);
+  }
+  open_.resize(threadCount_);
+  stats_.resize(threadCount_);
+}
+
+HDAStar::~HDAStar() { }
+
+SearchAlgorithm::Status HDAStar::expand(CellEventBuffer* events)
+{
+  // The first steps run the search, and the last of them reports what each worker
+  // expanded.
+  if (!searched_) {
+    if (!search()) {
+      return Status::RUNNING;
+    }
+    searched_ = true;
+
+    for (size_t i = 0; i < expandedBy_.size(); i++) {
+      if (expandedBy_[i] < 0) {
+        continue;
+      }
+      auto cell = grid_->grid[i];
+      if (cell != startCell_ && cell != goalCell_) {
+        cell->vis = Cell::VisualizationState::CLOSED_LIST;
+      }
+      if (annotating(events)) {
+        cell->text_tr = std::to_string(expandedBy_[i]);
+        cell->text_bl = std::to_string(g_[i]);
+      }
+      record(events, cell);
+    }
+    return Status::RUNNING;
+  }
+
+  // Check if a path was found
+  if (g_[goalIndex_] == UINT_MAX) {
+    return Status::NO_PATH; // No path was found
+  }
+
+  // Reconstruct the path by following parents back from the goal.
+  if (path_.empty()) {
+    for (int i = goalIndex_; i != -1; i = parent_[i]) {
+      auto pathCell = grid_->grid[i];
+      if (pathCell != startCell_ && pathCell != goalCell_) {
+        pathCell->vis = Cell::VisualizationState::PATH;
+      }
+      path_.push_back(pathCell);
+    }
+    std::reverse(path_.begin(), path_.end());
+
+    std::cout << "Path found!" << std::endl;
+  }
+
+  return Status::FOUND;
+}
+
+std::vector<std::shared_ptr<Grid::Cell>> HDAStar::path() { return path_; }
+
+const std::vector<HDAStar::ThreadStats>& HDAStar::threadStats() const { return stats_; }
+
+bool HDAStar::search()
+{
+  // Seed the owner of the start cell with the start cell.
+  if (!started_) {
+    Message seed = { startIndex_, 0, -1 };
+    outstanding_ = 1;
+    inboxes_[owner(startIndex_)]->push(seed);
+    started_ = true;
+  }
+
+  // Run the workers.
+  std::vector<std::thread> workers;
+  for (unsigned int id = 0; id < threadCount_; id++) {
+    workers.emplace_back(&HDAStar::work, this, id);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  if (outstanding_.load(std::memory_order_acquire) > 0) {
+    return false;
+  }
+  for (const ThreadStats& stats : stats_) {
+    count().add(stats.counters);
+  }
+  return true;
+}
+
+void HDAStar::work(unsigned int id)
+{
+  MpscQueue<Message>& inbox = *inboxes_[id];
+  std::priority_queue<OpenEntry>& open = open_[id];
+  ThreadStats stats = stats_[id];
+
+  const int width = width_;
+  const int height = grid_->getHeight();
+
+  /*
+   * Termination is detected with a single shared counter of outstanding cells. A cell
+   * is counted from the moment it is generated until it has been discarded, pruned or
+   * expanded. Successors are counted before they are published, so the counter can only
+   * reach zero once every inbox and every open list has been drained.
+   *
+   * Whether the run has to stop is only checked every few iterations, since it may
+   * read the clock. What is left in the inbox and the open list is picked up again by
+   * the next search.
+   */
+
+  unsigned long iterations = 0;
+  while (outstanding_.load(std::memory_order_acquire) > 0) {
+    if (++iterations % STOP_CHECK_INTERVAL == 0 && stopping()) {
+      break;
+    }
+
+    // Receive cells from other workers (and the seed).
+    Message message;
+    while (inbox.pop(message)) {
+      if (message.parent != -1) {
+        stats.messagesReceived++;
+      }
+      if (message.g >= g_[message.index]) {
+        outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+        continue;
+      }
+      if (g_[message.index] != UINT_MAX) {
+        stats.counters.decreaseKey();
+      }
+      g_[message.index] = message.g;
+      parent_[message.index] = message.parent;
+      if (message.index == goalIndex_) {
+        offerIncumbent(message.g);
+        outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+        continue;
+      }
+      open.push({ message.g + heuristic(message.index), message.g, message.index });
+      stats.counters.push(open.size());
+    }
+
+    // Nothing to do until another worker sends something.
+    if (open.empty()) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    OpenEntry entry = open.top();
+    open.pop();
+
+    // Skip entries that were superseded by a cheaper path.
+    if (entry.g != g_[entry.index]) {
+      stats.counters.stalePop();
+      outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+      continue;
+    }
+
+    // Once the best entry cannot beat the incumbent, neither can the rest.
+    if (entry.f >= incumbent_.load(std::memory_order_acquire)) {
+      outstanding_.fetch_sub(1 + (long)open.size(), std::memory_order_acq_rel);
+      open = std::priority_queue<OpenEntry>();
+      continue;
+    }
+
+    // Expand the cell.
+    stats.expansions++;
+    expandedBy_[entry.index] = id;
+
+    const int x = entry.index % width;
+    const int y = entry.index / width;
+    int neighbors[4];
+    int neighborCount = 0;
+    if (x > 0) {
+      neighbors[neighborCount++] = entry.index - 1;
+    }
+    if (x < width - 1) {
+      neighbors[neighborCount++] = entry.index + 1;
+    }
+    if (y > 0) {
+      neighbors[neighborCount++] = entry.index - width;
+    }
+    if (y < height - 1) {
+      neighbors[neighborCount++] = entry.index + width;
+    }
+
+    // Collect the successors that might still improve on the incumbent.
+    Message successors[4];
+    int successorCount = 0;
+    const unsigned int incumbent = incumbent_.load(std::memory_order_acquire);
+    for (int i = 0; i < neighborCount; i++) {
+      const int neighbor = neighbors[i];
+      if (cost_[neighbor] == Cell::WALL_COST) {
+        continue;
+      }
+      const unsigned int newG = entry.g + cost_[neighbor];
+      if (newG + heuristic(neighbor) >= incumbent) {
+        continue;
+      }
+
+      // Local successors can be filtered now, without counting them.
+      if (owner(neighbor) == id && newG >= g_[neighbor]) {
+        continue;
+      }
+      successors[successorCount++] = { neighbor, newG, entry.index };
+    }
+
+    // Count the successors and retire the expanded cell in one update.
+    outstanding_.fetch_add(successorCount - 1, std::memory_order_acq_rel);
+
+    for (int i = 0; i < successorCount; i++) {
+      const Message& successor = successors[i];
+      const unsigned int successorOwner = owner(successor.index);
+      if (successorOwner != id) {
+        stats.messagesSent++;
+        inboxes_[successorOwner]->push(successor);
+        continue;
+      }
+
+      if (g_[successor.index] != UINT_MAX) {
+        stats.counters.decreaseKey();
+      }
+      g_[successor.index] = successor.g;
+      parent_[successor.index] = successor.parent;
+      if (successor.index == goalIndex_) {
+        offerIncumbent(successor.g);
+        outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+        continue;
+      }
+      open.push({ successor.g + heuristic(successor.index), successor.g,
+          successor.index });
+      stats.counters.push(open.size());
+    }
+  }
+
+  stats.counters.expansions = stats.expansions;
+  stats_[id] = stats;
+}
+
+unsigned int HDAStar::owner(int index) const
+{
+  // Multiplicative hashing scatters neighboring cells across workers.
+  const unsigned long long hash = (unsigned int)index * 2654435761u;
+  return (unsigned int)(((hash & 0xffffffffu) * threadCount_) >> 32);
+}
+
+unsigned int HDAStar::heuristic(int index) const
+{
+  return Heuristics::manhattan(
+      index % width_, index / width_, goalCell_->x, goalCell_->y);
+}
+
+void HDAStar::offerIncumbent(unsigned int cost)
+{
+  unsigned int current = incumbent_.load(std::memory_order_acquire);
+  while (cost < current
+      && !incumbent_.compare_exchange_weak(
+          current, cost, std::memory_order_acq_rel)) { }
+}
+
+bool HDAStar::OpenEntry::operator<(const OpenEntry& other) const
+{
+  // std::priority_queue is a max-heap, so the lowest f must compare greatest.
+  // Ties are broken towards the deeper cell.
+  if (f != other.f) {
+    return f > other.f;
+  }
+  return g < other.g;
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
@@ -0,0 +1,177 @@
+#ifndef HDA_STAR_H
+#define HDA_STAR_H
+
+#include <atomic>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "../grid.h"
+#include "heuristics.h"
+#include "mpsc_queue.h"
+#include "search_algorithm.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * Hash-distributed A* (HDA*).
+ *
+ * Cells are partitioned across worker threads by hashing their index. Each worker owns
+ * the open list and g-values of its cells and expands them independently. Generated
+ * cells that belong to another worker are sent to it through a lock-free queue. The
+ * cost of the best path found so far (the incumbent) is shared between workers and
+ * used both for pruning and for termination.
+ *
+ * The parallel search runs in the first expansions. Each one runs the workers until the
+ * search finishes or the run has to stop, keeping their open lists and inboxes so that
+ * the next expansion carries on where they left off.
+ */
+class HDAStar : public SearchAlgorithm {
+
+  public:
+
+  /**
+   * Load balancing statistics for a single worker thread.
+   */
+  struct ThreadStats {
+    unsigned long expansions = 0; // The number of cells expanded.
+    unsigned long messagesSent = 0; // The number of cells sent to other workers.
+    unsigned long messagesReceived = 0; // The number of cells received from others.
+    SearchCounters counters; // The worker's share of the search's counts.
+  };
+
+  /**
+   * Construct a new HDAStar.
+   *
+   * \param grid The grid to step through.
+   * \param start The start cell.
+   * \param goal The goal cell.
+   * \param threadCount The number of worker threads (0 to use all cores).
+   */
+  HDAStar(std::shared_ptr<Grid> grid, const std::shared_ptr<Grid::Cell> start,
+      const std::shared_ptr<Grid::Cell> goal, unsigned int threadCount = 0);
+
+  /**
+   * Destroy an HDAStar.
+   */
+  ~HDAStar();
+
+  /**
+   * Get the path found by the search algorithm.
+   * This function should only be called after the algorithm has finished.
+   * An empty vector will be returned if no path was found or the algorithm has not
+   * finished.
+   *
+   * \return A vector of cells that are in the path.
+   */
+  std::vector<std::shared_ptr<Grid::Cell>> path();
+
+  /**
+   * Get the per-thread statistics of the last search.
+   *
+   * \return One entry per worker thread.
+   */
+  const std::vector<ThreadStats>& threadStats() const;
+
+  protected:
+
+  /**
+   * Run the HDA* algorithm.
+   * The first calls run the parallel search until it finishes, and the one that
+   * finishes it records every expanded cell. The next call reconstructs the path.
+   *
+   * \param events If not null, an event is added to this for every cell that changed.
+   * \return RUNNING if there is more work to do, otherwise FOUND or NO_PATH.
+   */
+  Status expand(CellEventBuffer* events) override;
+
+  private:
+
+  /**
+   * A cell sent from one worker to the worker that owns it.
+   */
+  struct Message {
+    int index; // The index of the cell.
+    unsigned int g; // The cost to get to the cell.
+    int parent; // The index of the parent of the cell, or -1.
+  };
+
+  /**
+   * An entry in a worker's open list.
+   */
+  struct OpenEntry {
+    unsigned int f; // The total cost of the cell.
+    unsigned int g; // The cost to get to the cell when it was pushed.
+    int index; // The index of the cell.
+
+    bool operator<(const OpenEntry& other) const;
+  };
+
+  /**
+   * Run the parallel search until it finishes or the run has to stop.
+   *
+   * \return True if the search has finished.
+   */
+  bool search();
+
+  /**
+   * The main loop of a worker thread.
+   *
+   * \param id The id of the worker.
+   */
+  void work(unsigned int id);
+
+  /**
+   * Get the worker that owns a cell.
+   *
+   * \param index The index of the cell.
+   * \return The id of the owning worker.
+   */
+  unsigned int owner(int index) const;
+
+  /**
+   * Get the heuristic cost from a cell to the goal.
+   *
+   * \param index The index of the cell.
+   * \return The heuristic cost.
+   */
+  unsigned int heuristic(int index) const;
+
+  /**
+   * Lower the shared incumbent cost if the given cost is better.
+   *
+   * \param cost The cost of a newly found path to the goal.
+   */
+  void offerIncumbent(unsigned int cost);
+
+  /*
+   * Data.
+   */
+
+  std::shared_ptr<Grid> grid_; // The grid to step through.
+  std::shared_ptr<Grid::Cell> startCell_; // The start cell.
+  std::shared_ptr<Grid::Cell> goalCell_; // The goal cell.
+  std::vector<std::shared_ptr<Grid::Cell>> path_; // The path found by the algorithm.
+
+  int width_; // The width of the grid.
+  int startIndex_; // The index of the start cell.
+  int goalIndex_; // The index of the goal cell.
+  unsigned int threadCount_; // The number of worker threads.
+  bool started_ = false; // Whether the start cell has been handed to its owner.
+  bool searched_ = false; // Whether the parallel search has finished.
+
+  std::vector<unsigned int> cost_; // A snapshot of the cell costs.
+  std::vector<unsigned int> g_; // The cost to get to each cell (owner-written).
+  std::vector<int> parent_; // The parent of each cell (owner-written).
+  std::vector<int> expandedBy_; // The worker that last expanded each cell, or -1.
+
+  std::vector<std::unique_ptr<MpscQueue<Message>>> inboxes_; // One inbox per worker.
+  std::vector<std::priority_queue<OpenEntry>> open_; // One open list per worker.
+  std::vector<ThreadStats> stats_; // One entry per worker.
+
+  std::atomic<unsigned int> incumbent_; // The cost of the best path found so far.
+  std::atomic<long> outstanding_; // Cells generated but not yet fully processed.
+};
+}
+
+#endif
\ No newline at end of file
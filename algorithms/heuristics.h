@@ -0,0 +1,77 @@
+#ifndef HEURISTICS_H
+#define HEURISTICS_H
+
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+#include "../grid.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * Heuristics shared by the informed search algorithms.
+ * Keeping them in one place means that engines built on the same heuristic expand the
+ * same cells, so their expansions and timings can be compared directly.
+ */
+namespace Heuristics {
+
+/**
+ * Get the Manhattan distance from a cell to the goal.
+ * Every move enters a cell, so this never overestimates as long as `scale` is no more
+ * than the cost of the cheapest passable cell.
+ *
+ * \param x The x coordinate of the cell.
+ * \param y The y coordinate of the cell.
+ * \param goalX The x coordinate of the goal.
+ * \param goalY The y coordinate of the goal.
+ * \param scale The cost of a single move.
+ * \return The heuristic cost.
+ */
+inline unsigned int manhattan(
+    int x, int y, int goalX, int goalY, unsigned int scale = 1)
+{
+  return (abs(x - goalX) + abs(y - goalY)) * scale;
+}
+
+/**
+ * Get the straight-line distance from a cell to the goal.
+ * This suits any-angle searches, which can move in a straight line between any two
+ * cells, and never overestimates under the same condition as `manhattan()`.
+ *
+ * \param x The x coordinate of the cell.
+ * \param y The y coordinate of the cell.
+ * \param goalX The x coordinate of the goal.
+ * \param goalY The y coordinate of the goal.
+ * \param scale The cost of moving one cell width.
+ * \return The heuristic cost.
+ */
+inline double euclidean(int x, int y, int goalX, int goalY, double scale = 1)
+{
+  const double dx = x - goalX;
+  const double dy = y - goalY;
+  return std::sqrt(dx * dx + dy * dy) * scale;
+}
+
+/**
+ * Get the cost of the cheapest passable cell in a grid.
+ * This is the largest scale that keeps `manhattan()` and `euclidean()` admissible.
+ *
+ * \param grid The grid.
+ * \return The cheapest cost of entering a cell, or 1 if every cell is a wall.
+ */
+inline unsigned int cheapestCost(const Grid& grid)
+{
+  unsigned int cheapest = UINT_MAX;
+  for (int i = 0; i < grid.getWidth() * grid.getHeight(); i++) {
+    const unsigned int cost = grid.grid[i]->cost;
+    if (cost != Grid::Cell::WALL_COST && cost < cheapest) {
+      cheapest = cost;
+    }
+  }
+  return cheapest == UINT_MAX ? 1 : cheapest;
+}
+}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "line_of_sight.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using Cell = Grid::Cell;
+
+namespace SearchAlgorithms {
+
+LineOfSight::LineOfSight(const Grid& grid)
+    : width_(grid.getWidth())
+{
+  const int size = width_ * grid.getHeight();
+  cost_.resize(size);
+  walls_.assign((size + 63) / 64, 0);
+  for (int i = 0; i < size; i++) {
+    cost_[i] = grid.grid[i]->cost;
+    if (cost_[i] == Cell::WALL_COST) {
+      walls_[i / 64] |= (uint64_t)1 << (i % 64);
+    }
+  }
+}
+
+bool LineOfSight::visible(int from, int to) const
+{
+  return walk(from, to, [](int) { });
+}
+
+bool LineOfSight::trace(int from, int to, double& cost) const
+{
+  unsigned long total = 0;
+  int count = 0;
+  if (!walk(from, to, [&](int index) {
+        total += cost_[index];
+        count++;
+      })) {
+    return false;
+  }
+
+  const double dx = to % width_ - from % width_;
+  const double dy = to / width_ - from / width_;
+  cost = count == 0 ? 0 : std::sqrt(dx * dx + dy * dy) * total / count;
+  return true;
+}
+
+std::vector<int> LineOfSight::cells(int from, int to) const
+{
+  std::vector<int> line;
+  walk(from, to, [&](int index) {
+    line.push_back(index);
+  });
+  return line;
+}
+
+template <typename F> bool LineOfSight::walk(int from, int to, F visit) const
+{
+  int x = from % width_;
+  int y = from / width_;
+  const int dx = abs(to % width_ - x);
+  const int dy = abs(to / width_ - y);
+  const int sx = to % width_ > x ? 1 : -1;
+  const int sy = to / width_ > y ? 1 : -1;
+
+  /*
+   * After `ix` steps along x and `iy` steps along y, the line leaves the current cell
+   * through its x side first if (ix + 1/2) / dx < (iy + 1/2) / dy. Multiplying out
+   * keeps the comparison in integers.
+   */
+
+  for (int ix = 0, iy = 0; ix < dx || iy < dy;) {
+    const long side = (long)(1 + 2 * ix) * dy - (long)(1 + 2 * iy) * dx;
+
+    // Through a corner, the line steps along x first, but the cell that it skips past
+    // along y must be open too.
+    if (side == 0 && wall((y + sy) * width_ + x)) {
+      return false;
+    }
+    if (side <= 0) {
+      x += sx;
+      ix++;
+    } else {
+      y += sy;
+      iy++;
+    }
+
+    const int index = y * width_ + x;
+    if (wall(index)) {
+      return false;
+    }
+    visit(index);
+  }
+
+  return true;
+}
+
+bool LineOfSight::wall(int index) const
+{
+  return (walls_[index / 64] >> (index % 64)) & 1;
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
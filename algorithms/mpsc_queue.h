@@ -0,0 +1,113 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+
+namespace SearchAlgorithms {
+
+/**
+ * A lock-free multi-producer single-consumer queue.
+ * Any number of threads may push, but only one thread may pop.
+ *
+ * This is an intrusive linked list with a dummy node: producers swap themselves in at
+ * the head with a single atomic exchange, and the consumer follows the `next` links
+ * from the tail. A push that has swapped the head but not yet linked its predecessor
+ * is briefly invisible to the consumer, so `pop` may report an empty queue while a
+ * push is still in flight. Callers must not treat an empty pop as termination.
+ */
+template <typename T> class MpscQueue {
+  public:
+
+  /**
+   * Construct a new, empty MpscQueue.
+   */
+  MpscQueue()
+      : head_(&stub_)
+      , tail_(&stub_)
+  {
+    stub_.next.store(nullptr, std::memory_order_relaxed);
+  }
+
+  /**
+   * Destroy a MpscQueue.
+   * Any values still in the queue are discarded.
+   */
+  ~MpscQueue()
+  {
+    T discard;
+    while (pop(discard)) { }
+    if (tail_ != &stub_) {
+      delete tail_;
+    }
+  }
+
+  /**
+   * Don't allow the queue to be copied.
+   */
+  MpscQueue(MpscQueue const&) = delete;
+
+  /**
+   * Don't allow the queue to be assigned.
+   */
+  void operator=(MpscQueue const&) = delete;
+
+  /**
+   * Push a value onto the queue.
+   * This may be called from any thread.
+   *
+   * \param value The value to push.
+   */
+  void push(const T& value)
+  {
+    Node* node = new Node;
+    node->value = value;
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  /**
+   * Pop a value from the queue.
+   * This may only be called from the consumer thread.
+   *
+   * \param value Set to the popped value if one was available.
+   * \return True if a value was popped, false if the queue appeared empty.
+   */
+  bool pop(T& value)
+  {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return false;
+    }
+
+    // The popped node becomes the new dummy node.
+    value = next->value;
+    tail_ = next;
+    if (tail != &stub_) {
+      delete tail;
+    }
+    return true;
+  }
+
+  private:
+
+  /**
+   * A node in the queue.
+   */
+  struct Node {
+    std::atomic<Node*> next; // The next node in the queue.
+    T value; // The value held by the node.
+  };
+
+  /*
+   * Data.
+   */
+
+  std::atomic<Node*> head_; // The most recently pushed node (producer side).
+  Node* tail_; // The dummy node preceding the oldest value (consumer side).
+  Node stub_; // The initial dummy node.
+};
+}
+
+#endif
\ No newline at end of file
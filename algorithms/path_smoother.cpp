@@ -0,0 +1,82 @@
+#include "path_smoother.h"
+
+#include <chrono>
+#include <cmath>
+
+using Cell = Grid::Cell;
+
+namespace SearchAlgorithms {
+
+PathSmoother::PathSmoother(std::shared_ptr<Grid> grid)
+    : grid_(grid)
+    , width_(grid->getWidth())
+    , lineOfSight_(*grid)
+{
+}
+
+PathSmoother::Result PathSmoother::smooth(
+    const std::vector<std::shared_ptr<Cell>>& path) const
+{
+  auto begin = std::chrono::steady_clock::now();
+
+  Result result;
+  result.lengthBefore = path.empty() ? 0 : path.size() - 1;
+  result.lengthAfter = 0;
+  result.costBefore = 0;
+  result.costAfter = 0;
+
+  // The cost of the original path up to each of its cells.
+  std::vector<double> costTo(path.size(), 0);
+  for (size_t i = 1; i < path.size(); i++) {
+    costTo[i] = costTo[i - 1] + path[i]->cost;
+  }
+  if (!path.empty()) {
+    result.costBefore = costTo.back();
+    result.path.push_back(path.front());
+    result.waypoints.push_back(path.front());
+  }
+
+  /*
+   * From each corner, look along the path for the furthest cell that can be reached
+   * with a straight line costing no more than the path does. Looking further stops at
+   * the first cell that fails, which keeps the work close to linear for paths that
+   * bend often.
+   */
+
+  size_t anchor = 0;
+  while (anchor + 1 < path.size()) {
+    const int from = path[anchor]->y * width_ + path[anchor]->x;
+    size_t best = anchor + 1;
+    double bestCost = costTo[best] - costTo[anchor];
+
+    for (size_t next = anchor + 2; next < path.size(); next++) {
+      double lineCost;
+      const int to = path[next]->y * width_ + path[next]->x;
+      if (!lineOfSight_.trace(from, to, lineCost)
+          || lineCost > costTo[next] - costTo[anchor]) {
+        break;
+      }
+      best = next;
+      bestCost = lineCost;
+    }
+
+    // Fill in the line with the cells that it crosses.
+    const int to = path[best]->y * width_ + path[best]->x;
+    for (int index : lineOfSight_.cells(from, to)) {
+      result.path.push_back(grid_->grid[index]);
+    }
+
+    const double dx = path[best]->x - path[anchor]->x;
+    const double dy = path[best]->y - path[anchor]->y;
+    result.lengthAfter += std::sqrt(dx * dx + dy * dy);
+    result.costAfter += bestCost;
+    result.waypoints.push_back(path[best]);
+    anchor = best;
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  result.milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+
+  return result;
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef PATH_SMOOTHER_H
+#define PATH_SMOOTHER_H
+
+#include <memory>
+#include <vector>
+
+#include "../grid.h"
+#include "line_of_sight.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * A post-processing stage that shortens paths found by any search algorithm.
+ *
+ * The path is pulled tight like a string. Starting from the first cell, the path is
+ * replaced by a straight line to the furthest later cell that is in sight, as long as
+ * the line costs no more than the part of the path that it replaces, and the process
+ * repeats from the end of the line. Lines are costed in the same way as in ThetaStar
+ * (their length times the average cost of the cells that they cross), so a shortcut
+ * through expensive cells is only taken when it actually pays off.
+ *
+ * The line-of-sight structure is built once per grid, so one PathSmoother can be used
+ * for any number of paths over the same grid.
+ */
+class PathSmoother {
+
+  public:
+
+  /**
+   * The result of smoothing a path.
+   */
+  struct Result {
+    std::vector<std::shared_ptr<Grid::Cell>> path; // The cells along the new path.
+    std::vector<std::shared_ptr<Grid::Cell>> waypoints; // The corners of the new path.
+    double lengthBefore; // The length of the original path, in cell widths.
+    double lengthAfter; // The length of the new path, in cell widths.
+    double costBefore; // The cost of the original path.
+    double costAfter; // The cost of the new path.
+    double milliseconds; // The time taken to smooth the path.
+  };
+
+  /**
+   * Construct a new PathSmoother.
+   *
+   * \param grid The grid that paths will be smoothed over.
+   */
+  PathSmoother(std::shared_ptr<Grid> grid);
+
+  /**
+   * Smooth a path.
+   *
+   * \param path A path of neighboring cells, as returned by `SearchAlgorithm::path()`.
+   * \return The smoothed path and its statistics.
+   */
+  Result smooth(const std::vector<std::shared_ptr<Grid::Cell>>& path) const;
+
+  private:
+
+  /*
+   * Data.
+   */
+
+  std::shared_ptr<Grid> grid_; // The grid that paths are smoothed over.
+  int width_; // The width of the grid.
+  LineOfSight lineOfSight_; // Line-of-sight checks over the grid.
+};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "search_algorithm.h"
+
+#include <chrono>
+
+#include "../profiler.h"
+
+namespace SearchAlgorithms {
+
+SearchAlgorithm::~SearchAlgorithm() { }
+
+SearchAlgorithm::Status SearchAlgorithm::run(unsigned long maxExpansions,
+    double maxMilliseconds, CellEventBuffer* events)
+{
+  PROFILE_SCOPE("SearchAlgorithm::run");
+
+  /*
+   * Reading the clock costs about as much as a small expansion, so the time budget is
+   * only checked every few expansions.
+   */
+
+  constexpr unsigned long clockInterval = 16;
+  auto begin = std::chrono::steady_clock::now();
+  timed_ = maxMilliseconds > 0;
+  deadline_ = begin
+      + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double, std::milli>(maxMilliseconds));
+  expired_.store(false, std::memory_order_relaxed);
+
+  for (unsigned long done = 0; status_ == Status::RUNNING; done++) {
+    if (interrupted_.load(std::memory_order_relaxed)) {
+      interrupted_.store(false, std::memory_order_relaxed);
+      break;
+    }
+    if (maxExpansions != 0 && done >= maxExpansions) {
+      break;
+    }
+    if (expired_.load(std::memory_order_relaxed)
+        || (timed_ && done % clockInterval == clockInterval - 1 && stopping())) {
+      break;
+    }
+
+    status_ = expand(events);
+    if (status_ == Status::RUNNING) {
+      expansionCount_++;
+    }
+    if (events != nullptr) {
+      events->endExpansion();
+    }
+  }
+  timed_ = false;
+
+#if SEARCH_COUNTERS
+  auto end = std::chrono::steady_clock::now();
+  counters_.milliseconds
+      += std::chrono::duration<double, std::milli>(end - begin).count();
+#endif
+  return status_;
+}
+
+SearchAlgorithm::Status SearchAlgorithm::runToCompletion()
+{
+  PROFILE_SCOPE("SearchAlgorithm::runToCompletion");
+#if SEARCH_COUNTERS
+  auto begin = std::chrono::steady_clock::now();
+#endif
+  while (status_ == Status::RUNNING) {
+    if (interrupted_.load(std::memory_order_relaxed)) {
+      interrupted_.store(false, std::memory_order_relaxed);
+      break;
+    }
+    status_ = expand(nullptr);
+    if (status_ == Status::RUNNING) {
+      expansionCount_++;
+    }
+  }
+#if SEARCH_COUNTERS
+  auto end = std::chrono::steady_clock::now();
+  counters_.milliseconds
+      += std::chrono::duration<double, std::milli>(end - begin).count();
+#endif
+  return status_;
+}
+
+void SearchAlgorithm::interrupt()
+{
+  interrupted_.store(true, std::memory_order_relaxed);
+}
+
+bool SearchAlgorithm::stopping()
+{
+  if (interrupted_.load(std::memory_order_relaxed)
+      || expired_.load(std::memory_order_relaxed)) {
+    return true;
+  }
+  if (timed_ && std::chrono::steady_clock::now() >= deadline_) {
+    expired_.store(true, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+bool SearchAlgorithm::finishIfUnreachable(Grid& grid,
+    const std::shared_ptr<Grid::Cell>& start, const std::shared_ptr<Grid::Cell>& goal)
+{
+  if (grid.connected(start, goal)) {
+    return false;
+  }
+  status_ = Status::NO_PATH;
+  return true;
+}
+
+SearchAlgorithm::Status SearchAlgorithm::status() const { return status_; }
+
+unsigned long SearchAlgorithm::expansions() const { return expansionCount_; }
+
+SearchCounters SearchAlgorithm::counters() const
+{
+  SearchCounters counters = counters_;
+  counters.expansions += expansionCount_;
+  return counters;
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
@@ -1,38 +1,69 @@
 #ifndef SEARCH_ALGORITHM_H
 #define SEARCH_ALGORITHM_H
 
-#include <exception>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <vector>
 
 #include "../grid.h"
+#include "cell_events.h"
+#include "search_counters.h"
 
 namespace SearchAlgorithms {
 
-/**
- * Exception thrown when no path is found.
- */
-class NoPathFoundException : public std::exception {
-  public:
-  const char* what() const throw() { return "No path found."; }
-};
-
 /**
  * Base class for search algorithms.
+ *
+ * Search algorithms implement `expand()`, which does a single unit of work. The base
+ * class drives it: `run()` does as much work as a budget allows, and
+ * `runToCompletion()` runs the search to the end without recording anything for the
+ * graphics area.
  */
 class SearchAlgorithm {
   public:
 
   /**
-   * Step through the search algorithm.
-   * Cells will be updated in this function.
-   * A vector of cells that were updated will be returned, so that the graphics area can
-   * update them.
-   * An empty vector will be returned if the algorithm is finished.
+   * The state of a search.
+   */
+  enum class Status {
+    RUNNING, // The search has more work to do.
+    FOUND, // A path was found and is available from `path()`.
+    NO_PATH // The search finished without finding a path.
+  };
+
+  /**
+   * Destroy a SearchAlgorithm.
+   */
+  virtual ~SearchAlgorithm();
+
+  /**
+   * Run the search until it finishes or a budget runs out, whichever comes first.
+   * Nothing is thrown: the outcome is returned instead.
+   *
+   * \param maxExpansions The most expansions to do (0 for no limit).
+   * \param maxMilliseconds The most time to spend, in milliseconds (0 for no limit).
+   * \param events If not null, an event is added to this for every cell that changed,
+   *               and the end of every expansion is marked.
+   * \return The state of the search after the run.
+   */
+  Status run(unsigned long maxExpansions, double maxMilliseconds = 0,
+      CellEventBuffer* events = nullptr);
+
+  /**
+   * Run the search to the end as fast as possible.
+   * No events are recorded and no budget is checked.
    *
-   * \return A vector of cells that were updated.
+   * \return FOUND or NO_PATH, or RUNNING if the search was interrupted.
    */
-  virtual std::vector<std::shared_ptr<Grid::Cell>> step() = 0;
+  Status runToCompletion();
+
+  /**
+   * Ask the current run to stop as soon as it can, leaving the search running.
+   * This may be called from any thread. If no run is in progress, the next one stops
+   * straight away.
+   */
+  void interrupt();
 
   /**
    * Get the path found by the search algorithm.
@@ -43,6 +74,110 @@ class SearchAlgorithm {
    * \return A vector of cells that are in the path.
    */
   virtual std::vector<std::shared_ptr<Grid::Cell>> path() = 0;
+
+  /**
+   * Get the state of the search.
+   *
+   * \return The state of the search.
+   */
+  Status status() const;
+
+  /**
+   * Get the number of expansions done so far.
+   *
+   * \return The number of calls to `expand()` that did not finish the search.
+   */
+  unsigned long expansions() const;
+
+  /**
+   * Get the counts of what the search has done so far.
+   * Only the expansions are counted unless the build has SEARCH_COUNTERS set.
+   *
+   * \return The counts.
+   */
+  SearchCounters counters() const;
+
+  protected:
+
+  /**
+   * Do a single unit of work, usually expanding one cell.
+   * This is only called while the search is running.
+   *
+   * \param events If not null, an event should be added to this for every cell that
+   *               changed (see `record()`).
+   * \return RUNNING if there is more work to do, otherwise FOUND or NO_PATH.
+   */
+  virtual Status expand(CellEventBuffer* events) = 0;
+
+  /**
+   * Finish the search with no path if the goal is walled off from the start.
+   * Engines call this before building any search state; `run()` and
+   * `runToCompletion()` then return NO_PATH without calling `expand()`.
+   *
+   * \param grid The grid being searched.
+   * \param start The start cell.
+   * \param goal The goal cell.
+   * \return True if the goal is unreachable, so the search is already finished.
+   */
+  bool finishIfUnreachable(Grid& grid, const std::shared_ptr<Grid::Cell>& start,
+      const std::shared_ptr<Grid::Cell>& goal);
+
+  /**
+   * Record that a cell changed, if events are being collected.
+   *
+   * \param events The event buffer, or nullptr.
+   * \param cell The cell that changed.
+   */
+  static void record(CellEventBuffer* events, const std::shared_ptr<Grid::Cell>& cell)
+  {
+    if (events != nullptr) {
+      events->push(*cell);
+    }
+  }
+
+  /**
+   * Check whether recorded cells should be annotated.
+   * Annotations are only formatted when events are being collected for drawing.
+   *
+   * \param events The event buffer, or nullptr.
+   * \return True if cells should be annotated.
+   */
+  static bool annotating(const CellEventBuffer* events)
+  {
+    return events != nullptr && events->annotate();
+  }
+
+  /**
+   * Check whether the current run should stop, because its time budget has run out or
+   * it was interrupted. Engines whose expansions take a long time call this as they
+   * work, from any of their threads, and return RUNNING to carry on in the next run.
+   *
+   * \return True if the run should stop.
+   */
+  bool stopping();
+
+  /**
+   * Get the counts for the search algorithm to add to as it works.
+   * The expansions and the time are counted by the base class.
+   *
+   * \return The counts.
+   */
+  SearchCounters& count() { return counters_; }
+
+  private:
+
+  /*
+   * Data.
+   */
+
+  Status status_ = Status::RUNNING; // The state of the search.
+  unsigned long expansionCount_ = 0; // The number of expansions done so far.
+  SearchCounters counters_; // What the search has done so far.
+
+  bool timed_ = false; // Whether the current run has a time budget.
+  std::chrono::steady_clock::time_point deadline_; // When the time budget runs out.
+  std::atomic<bool> expired_ { false }; // Whether the time budget has run out.
+  std::atomic<bool> interrupted_ { false }; // Whether `interrupt()` was called.
 };
 }
 
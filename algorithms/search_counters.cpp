@@ -0,0 +1,36 @@
+#include "search_counters.h"
+
+#include <sstream>
+
+namespace SearchAlgorithms {
+
+constexpr bool SearchCounters::ENABLED;
+
+void SearchCounters::add(const SearchCounters& other)
+{
+  expansions += other.expansions;
+  pushes += other.pushes;
+  stalePops += other.stalePops;
+  decreaseKeys += other.decreaseKeys;
+  peakOpen += other.peakOpen;
+  stateBytes += other.stateBytes;
+  milliseconds += other.milliseconds;
+}
+
+double SearchCounters::millisecondsPerExpansion() const
+{
+  return expansions > 0 ? milliseconds / expansions : 0;
+}
+
+std::string SearchCounters::json() const
+{
+  std::ostringstream out;
+  out << "{ \"counters_enabled\": " << (ENABLED ? "true" : "false")
+      << ", \"expansions\": " << expansions << ", \"pushes\": " << pushes
+      << ", \"stale_pops\": " << stalePops << ", \"decrease_keys\": " << decreaseKeys
+      << ", \"peak_open\": " << peakOpen << ", \"state_bytes\": " << stateBytes
+      << ", \"milliseconds\": " << milliseconds
+      << ", \"ms_per_expansion\": " << millisecondsPerExpansion() << " }";
+  return out.str();
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
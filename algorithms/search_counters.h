@@ -0,0 +1,125 @@
+#ifndef SEARCH_COUNTERS_H
+#define SEARCH_COUNTERS_H
+
+#include <algorithm>
+#include <climits>
+#include <string>
+#include <vector>
+
+// Whether the search engines count what they do. Building with SEARCH_COUNTERS=0
+// compiles every count away, leaving only the expansions.
+#ifndef SEARCH_COUNTERS
+#define SEARCH_COUNTERS 1
+#endif
+
+namespace SearchAlgorithms {
+
+/**
+ * Counts of what a search did, for finding out where its time and memory went.
+ *
+ * The counts are plain integers, bumped by the search engine on its own thread. Every
+ * counting function is empty unless SEARCH_COUNTERS is set, so that a zero-cost build
+ * pays nothing for them.
+ */
+struct SearchCounters {
+  static constexpr bool ENABLED = SEARCH_COUNTERS; // Whether anything is counted.
+
+  unsigned long expansions = 0; // The number of expansions.
+  unsigned long pushes = 0; // The number of cells put in the open list.
+  unsigned long stalePops = 0; // Open list entries skipped as out of date.
+  unsigned long decreaseKeys = 0; // Cheaper paths found to cells already open.
+  size_t peakOpen = 0; // The most cells that were in the open list at once.
+  size_t stateBytes = 0; // The memory used for per-cell search state (bytes).
+  double milliseconds = 0; // The time spent searching.
+
+  /**
+   * Count a cell being put in the open list.
+   *
+   * \param openSize The size of the open list afterwards.
+   */
+  void push(size_t openSize)
+  {
+#if SEARCH_COUNTERS
+    pushes++;
+    peakOpen = std::max(peakOpen, openSize);
+#else
+    (void)openSize;
+#endif
+  }
+
+  /**
+   * Count an out-of-date open list entry being skipped.
+   */
+  void stalePop()
+  {
+#if SEARCH_COUNTERS
+    stalePops++;
+#endif
+  }
+
+  /**
+   * Count a cheaper path to a cell that is already open.
+   */
+  void decreaseKey()
+  {
+#if SEARCH_COUNTERS
+    decreaseKeys++;
+#endif
+  }
+
+  /**
+   * Count memory allocated for search state.
+   *
+   * \param bytes The number of bytes.
+   */
+  void state(size_t bytes)
+  {
+#if SEARCH_COUNTERS
+    stateBytes += bytes;
+#else
+    (void)bytes;
+#endif
+  }
+
+  /**
+   * Count the memory held by a vector of search state.
+   *
+   * \param values The vector.
+   */
+  template <typename T> void state(const std::vector<T>& values)
+  {
+    state(values.capacity() * sizeof(T));
+  }
+
+  /**
+   * Count the memory held by a vector of flags, which are packed into bits.
+   *
+   * \param values The vector.
+   */
+  void state(const std::vector<bool>& values) { state(values.capacity() / CHAR_BIT); }
+
+  /**
+   * Add the counts of a part of a search, such as one worker of a parallel search.
+   * The parts' peak open list sizes are added too, which bounds the combined peak.
+   *
+   * \param other The counts to add.
+   */
+  void add(const SearchCounters& other);
+
+  /**
+   * Get the average time per expansion.
+   *
+   * \return The time per expansion (ms), or 0 if nothing was expanded.
+   */
+  double millisecondsPerExpansion() const;
+
+  /**
+   * Get the counts as a JSON object.
+   *
+   * \return The JSON text, on one line.
+   */
+  std::string json() const;
+};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace SearchAlgorithms {
+
+/**
+ * A lock-free bounded single-producer single-consumer queue.
+ * One thread may push and one other thread may pop.
+ *
+ * This is a ring buffer whose capacity is rounded up to a power of two. The producer
+ * only writes the tail index and the consumer only writes the head index, so each side
+ * needs a single release store per operation and no read-modify-write. The indices are
+ * kept on separate cache lines so that the two threads do not fight over one line.
+ */
+template <typename T> class SpscQueue {
+  public:
+
+  /**
+   * Construct a new, empty SpscQueue.
+   *
+   * \param capacity The least number of values the queue can hold.
+   */
+  explicit SpscQueue(size_t capacity)
+      : head_(0)
+      , tail_(0)
+  {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    values_.resize(size);
+    mask_ = size - 1;
+  }
+
+  /**
+   * Don't allow the queue to be copied.
+   */
+  SpscQueue(SpscQueue const&) = delete;
+
+  /**
+   * Don't allow the queue to be assigned.
+   */
+  void operator=(SpscQueue const&) = delete;
+
+  /**
+   * Push a value onto the queue.
+   * This may only be called from the producer thread.
+   *
+   * \param value The value to push.
+   * \return True if the value was pushed, false if the queue was full.
+   */
+  bool push(const T& value)
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) > mask_) {
+      return false;
+    }
+    values_[tail & mask_] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Pop a value from the queue.
+   * This may only be called from the consumer thread.
+   *
+   * \param value Set to the popped value if one was available.
+   * \return True if a value was popped, false if the queue was empty.
+   */
+  bool pop(T& value)
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = values_[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  private:
+
+  /*
+   * Data.
+   */
+
+  alignas(64) std::atomic<size_t> head_; // The index of the oldest value.
+  alignas(64) std::atomic<size_t> tail_; // The index past the newest value.
+  alignas(64) std::vector<T> values_; // The ring buffer.
+  size_t mask_; // The capacity of the ring buffer, minus one.
+};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "subgoal_graph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+using Cell = Grid::Cell;
+
+namespace SearchAlgorithms {
+
+SubgoalGraph::SubgoalGraph(const Grid& grid)
+    : width_(grid.getWidth())
+    , height_(grid.getHeight())
+{
+  auto begin = std::chrono::steady_clock::now();
+
+  const int size = width_ * height_;
+  cost_.resize(size);
+  for (int i = 0; i < size; i++) {
+    cost_[i] = grid.grid[i]->cost;
+  }
+
+  /*
+   * Place a subgoal at every convex obstacle corner. A path that has to get around a
+   * wall cell diagonally next to a passable cell can always bend at that cell, so these
+   * are the only places where a shortest path needs to change direction.
+   */
+
+  subgoalNumber_.assign(size, -1);
+  int subgoals = 0;
+  for (int y = 0; y < height_; y++) {
+    for (int x = 0; x < width_; x++) {
+      if (!passable(x, y)) {
+        continue;
+      }
+      bool corner = false;
+      for (int dx = -1; dx <= 1 && !corner; dx += 2) {
+        for (int dy = -1; dy <= 1 && !corner; dy += 2) {
+          const int wx = x + dx;
+          const int wy = y + dy;
+          corner = wx >= 0 && wx < width_ && wy >= 0 && wy < height_
+              && !passable(wx, wy) && passable(wx, y) && passable(x, wy);
+        }
+      }
+      if (corner) {
+        subgoalNumber_[y * width_ + x] = subgoals++;
+      }
+    }
+  }
+
+  // Link each subgoal to the subgoals that are directly h-reachable from it.
+  edges_.resize(subgoals);
+  for (int i = 0; i < size; i++) {
+    if (subgoalNumber_[i] != -1) {
+      edges_[subgoalNumber_[i]] = connect(i);
+      edgeCount_ += edges_[subgoalNumber_[i]].size();
+    }
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  buildMilliseconds_ = std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+bool SubgoalGraph::subgoal(int index) const { return subgoalNumber_[index] != -1; }
+
+const std::vector<SubgoalGraph::Edge>& SubgoalGraph::edges(int index) const
+{
+  return edges_[subgoalNumber_[index]];
+}
+
+std::vector<SubgoalGraph::Edge> SubgoalGraph::connect(int index, int target) const
+{
+  std::vector<Edge> reached;
+  const int x0 = index % width_;
+  const int y0 = index / width_;
+
+  /*
+   * Every monotone path lies in one of the four quadrants around the cell. Each
+   * quadrant is swept row by row, away from the cell, keeping the cheapest monotone
+   * cost of reaching every cell. A cell can be reached from the cell before it in the
+   * same row or the cell before it in the previous row. Subgoals are recorded but not
+   * passed through, and the sweep stops as soon as a row has nothing left to extend.
+   */
+
+  const unsigned int unreachable = UINT_MAX;
+  std::vector<unsigned int> previous;
+  std::vector<unsigned int> current;
+
+  for (int dy = -1; dy <= 1; dy += 2) {
+    for (int dx = -1; dx <= 1; dx += 2) {
+      const int columns = (dx > 0 ? width_ - x0 : x0 + 1);
+      const int rows = (dy > 0 ? height_ - y0 : y0 + 1);
+      previous.assign(columns, unreachable);
+
+      for (int j = 0; j < rows; j++) {
+        current.assign(columns, unreachable);
+        bool extendable = false;
+
+        for (int i = 0; i < columns; i++) {
+          const int x = x0 + i * dx;
+          const int y = y0 + j * dy;
+          const int cell = y * width_ + x;
+
+          // The origin is reached for free.
+          if (i == 0 && j == 0) {
+            current[0] = 0;
+            extendable = true;
+            continue;
+          }
+
+          const unsigned int best
+              = std::min(previous[i], i > 0 ? current[i - 1] : unreachable);
+          if (best == unreachable || !passable(x, y)) {
+            continue;
+          }
+          const unsigned int cost = best + cost_[cell];
+
+          // Record subgoals and the target, but never walk through a subgoal.
+          if (subgoalNumber_[cell] != -1 || cell == target) {
+            reached.push_back({ cell, cost });
+          }
+          if (subgoalNumber_[cell] == -1) {
+            current[i] = cost;
+            extendable = true;
+          }
+        }
+
+        if (!extendable) {
+          break;
+        }
+        previous.swap(current);
+      }
+    }
+  }
+
+  // Cells on the axes are swept by two quadrants, so keep the cheaper of each.
+  std::sort(reached.begin(), reached.end(), [](const Edge& a, const Edge& b) {
+    return a.to < b.to || (a.to == b.to && a.cost < b.cost);
+  });
+  reached.erase(std::unique(reached.begin(), reached.end(),
+                    [](const Edge& a, const Edge& b) { return a.to == b.to; }),
+      reached.end());
+
+  return reached;
+}
+
+std::vector<int> SubgoalGraph::refine(int from, int to) const
+{
+  const int x0 = from % width_;
+  const int y0 = from / width_;
+  const int x1 = to % width_;
+  const int y1 = to / width_;
+  const int dx = x1 >= x0 ? 1 : -1;
+  const int dy = y1 >= y0 ? 1 : -1;
+  const int columns = abs(x1 - x0) + 1;
+  const int rows = abs(y1 - y0) + 1;
+
+  /*
+   * Find the cheapest monotone path within the bounding box of the two cells, then
+   * walk it back from the end, always stepping to the cheaper predecessor.
+   */
+
+  const unsigned int unreachable = UINT_MAX;
+  std::vector<unsigned int> best(columns * rows, unreachable);
+  best[0] = 0;
+  for (int j = 0; j < rows; j++) {
+    for (int i = 0; i < columns; i++) {
+      if (i == 0 && j == 0) {
+        continue;
+      }
+      const int x = x0 + i * dx;
+      const int y = y0 + j * dy;
+      const unsigned int left = i > 0 ? best[j * columns + i - 1] : unreachable;
+      const unsigned int up = j > 0 ? best[(j - 1) * columns + i] : unreachable;
+      const unsigned int before = std::min(left, up);
+      if (before != unreachable && passable(x, y)) {
+        best[j * columns + i] = before + cost_[y * width_ + x];
+      }
+    }
+  }
+
+  std::vector<int> cells;
+  int i = columns - 1;
+  int j = rows - 1;
+  if (best[j * columns + i] == unreachable) {
+    return cells;
+  }
+  while (i != 0 || j != 0) {
+    cells.push_back((y0 + j * dy) * width_ + x0 + i * dx);
+    const unsigned int left = i > 0 ? best[j * columns + i - 1] : unreachable;
+    const unsigned int up = j > 0 ? best[(j - 1) * columns + i] : unreachable;
+    if (left <= up) {
+      i--;
+    } else {
+      j--;
+    }
+  }
+  std::reverse(cells.begin(), cells.end());
+
+  return cells;
+}
+
+unsigned int SubgoalGraph::reverseCost(const Edge& edge, int from) const
+{
+  return edge.cost - cost_[edge.to] + cost_[from];
+}
+
+int SubgoalGraph::subgoalCount() const { return edges_.size(); }
+
+long SubgoalGraph::edgeCount() const { return edgeCount_; }
+
+double SubgoalGraph::buildMilliseconds() const { return buildMilliseconds_; }
+
+bool SubgoalGraph::passable(int x, int y) const
+{
+  return x >= 0 && x < width_ && y >= 0 && y < height_
+      && cost_[y * width_ + x] != Cell::WALL_COST;
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
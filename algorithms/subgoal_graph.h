@@ -0,0 +1,137 @@
+#ifndef SUBGOAL_GRAPH_H
+#define SUBGOAL_GRAPH_H
+
+#include <vector>
+
+#include "../grid.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * A simple subgoal graph (SUB) over a grid.
+ *
+ * Subgoals are placed at the convex corners of obstacles: passable cells whose
+ * diagonal neighbor is a wall while the two cells beside that wall are passable. Two
+ * cells are h-reachable if they are joined by a monotone path (one that only moves
+ * towards the target), since such a path is as short as the Manhattan distance. Each
+ * subgoal is linked to the subgoals that are directly h-reachable from it, without
+ * passing through another subgoal.
+ *
+ * A query connects the start and goal to the subgoals that are directly h-reachable
+ * from them, searches the resulting sparse graph, and refines every edge back into a
+ * monotone run of grid moves. On grids where every passable cell has the same cost this
+ * finds optimal paths. With varying costs the edges use the cheapest monotone path, and
+ * the result is only an approximation.
+ */
+class SubgoalGraph {
+
+  public:
+
+  /**
+   * A directed edge in the graph.
+   */
+  struct Edge {
+    int to; // The index of the cell that the edge leads to.
+    unsigned int cost; // The cost of the cheapest monotone path along the edge.
+  };
+
+  /**
+   * Construct a new SubgoalGraph and build it over a grid.
+   *
+   * \param grid The grid to build the graph over.
+   */
+  SubgoalGraph(const Grid& grid);
+
+  /**
+   * Get whether a cell is a subgoal.
+   *
+   * \param index The index of the cell.
+   * \return True if the cell is a subgoal.
+   */
+  bool subgoal(int index) const;
+
+  /**
+   * Get the edges leaving a subgoal.
+   *
+   * \param index The index of the subgoal cell.
+   * \return The edges leaving the subgoal.
+   */
+  const std::vector<Edge>& edges(int index) const;
+
+  /**
+   * Find the subgoals that are directly h-reachable from any cell.
+   * This is used to connect the start and goal of a query to the graph.
+   *
+   * \param index The index of the cell to connect.
+   * \param target The index of a cell to report if it is reached, or -1.
+   * \return An edge to each reachable subgoal (and to the target, if reached).
+   */
+  std::vector<Edge> connect(int index, int target = -1) const;
+
+  /**
+   * Refine an edge into grid moves.
+   *
+   * \param from The index of the cell at the start of the edge.
+   * \param to The index of the cell at the end of the edge.
+   * \return The cells along the cheapest monotone path, excluding `from`.
+   */
+  std::vector<int> refine(int from, int to) const;
+
+  /**
+   * Get the cost of an edge when it is walked in the opposite direction.
+   * The cost of a path counts every cell that is entered, so reversing it swaps the
+   * cost of the first cell for the cost of the last.
+   *
+   * \param edge The edge, leaving `from`.
+   * \param from The index of the cell that the edge leaves.
+   * \return The cost of walking from `edge.to` back to `from`.
+   */
+  unsigned int reverseCost(const Edge& edge, int from) const;
+
+  /**
+   * Get the number of subgoals.
+   *
+   * \return The number of subgoals.
+   */
+  int subgoalCount() const;
+
+  /**
+   * Get the number of directed edges between subgoals.
+   *
+   * \return The number of edges.
+   */
+  long edgeCount() const;
+
+  /**
+   * Get the time taken to build the graph.
+   *
+   * \return The build time in milliseconds.
+   */
+  double buildMilliseconds() const;
+
+  private:
+
+  /**
+   * Get whether a cell is in the grid and passable.
+   *
+   * \param x The x coordinate of the cell.
+   * \param y The y coordinate of the cell.
+   * \return True if the cell can be entered.
+   */
+  bool passable(int x, int y) const;
+
+  /*
+   * Data.
+   */
+
+  int width_; // The width of the grid.
+  int height_; // The height of the grid.
+  std::vector<unsigned int> cost_; // The cost of each cell.
+  std::vector<int> subgoalNumber_; // The number of each subgoal cell, or -1.
+  std::vector<std::vector<Edge>> edges_; // The edges leaving each subgoal, by number.
+  long edgeCount_ = 0; // The number of edges between subgoals.
+  double buildMilliseconds_ = 0; // The time taken to build the graph.
+};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "subgoal_search.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "bit_bfs.h"
+
+using Cell = Grid::Cell;
+
+namespace SearchAlgorithms {
+
+SubgoalSearch::SubgoalSearch(std::shared_ptr<Grid> grid,
+    const std::shared_ptr<Cell> start, const std::shared_ptr<Cell> goal,
+    std::shared_ptr<const SubgoalGraph> graph)
+    : graph_(graph)
+{
+  // Init grid
+  this->grid_ = grid;
+  this->startCell_ = start;
+  this->goalCell_ = goal;
+  width_ = grid_->getWidth();
+  startIndex_ = start->y * width_ + start->x;
+  goalIndex_ = goal->y * width_ + goal->x;
+
+  // If the goal is walled off, fail before building any search state.
+  if (finishIfUnreachable(*grid_, startCell_, goalCell_)) {
+    return;
+  }
+
+  if (graph_ == nullptr) {
+    graph_ = std::make_shared<SubgoalGraph>(*grid_);
+  }
+  if (!BitBFS::applicable(*grid_, startCell_)) {
+    std::cerr << "Warning: Cell costs vary, so the subgoal path may not be optimal."
+              << std::endl;
+  }
+
+  // Scale the heuristic by the cheapest cell, so that it never overestimates.
+  minCost_ = Heuristics::cheapestCost(*grid_);
+
+  const int size = width_ * grid_->getHeight();
+  for (int i = 0; i < size; i++) {
+    auto cell = grid_->grid[i];
+
+    // Reset visualization state
+    switch (cell->vis) {
+    case Cell::VisualizationState::PATH:
+    case Cell::VisualizationState::OPEN_LIST:
+    case Cell::VisualizationState::CLOSED_LIST:
+      cell->vis = Cell::VisualizationState::UNVISITED;
+    default:
+      break;
+    }
+  }
+
+  /*
+   * Link the start and goal into the graph. The start gets edges to the subgoals (and
+   * the goal) that are directly reachable from it. Edges into the goal are found by
+   * connecting the goal and walking the edges backwards.
+   */
+
+  startEdges_ = graph_->connect(startIndex_, goalIndex_);
+  for (const SubgoalGraph::Edge& edge : graph_->connect(goalIndex_)) {
+    goalEdges_[edge.to] = graph_->reverseCost(edge, goalIndex_);
+  }
+
+  g_.assign(size, UINT_MAX);
+  parent_.assign(size, -1);
+  closed_.assign(size, false);
+  count().state(g_);
+  count().state(parent_);
+  count().state(closed_);
+  g_[startIndex_] = 0;
+  open_.push({ heuristic(startIndex_), 0, startIndex_ });
+  count().push(open_.size());
+}
+
+SubgoalSearch::~SubgoalSearch() { }
+
+SearchAlgorithm::Status SubgoalSearch::expand(CellEventBuffer* events)
+{
+  // Skip entries that were superseded by a cheaper path.
+  while (!open_.empty() && closed_[open_.top().index]) {
+    open_.pop();
+    count().stalePop();
+  }
+
+  // Check if the open list is empty
+  if (open_.empty()) {
+    return Status::NO_PATH; // No path was found
+  }
+
+  const int index = open_.top().index;
+  open_.pop();
+
+  // If the goal has been found, the path can be refined.
+  // FOUND will be returned, indicating that the algorithm is finished.
+  if (index == goalIndex_) {
+    reconstructPath();
+    std::cout << "Path found!" << std::endl;
+    return Status::FOUND;
+  }
+
+  // Add the node to the closed list.
+  closed_[index] = true;
+  auto cell = grid_->grid[index];
+  if (cell != startCell_) {
+    cell->vis = Cell::VisualizationState::CLOSED_LIST;
+  }
+  record(events, cell);
+
+  // Relax an edge out of the node.
+  auto relax = [&](int to, unsigned int cost) {
+    const unsigned int newG = g_[index] + cost;
+    if (closed_[to] || newG >= g_[to]) {
+      return;
+    }
+    if (g_[to] != UINT_MAX) {
+      count().decreaseKey();
+    }
+    g_[to] = newG;
+    parent_[to] = index;
+    const unsigned int h = heuristic(to);
+    open_.push({ newG + h, newG, to });
+    count().push(open_.size());
+
+    auto neighbor = grid_->grid[to];
+    if (annotating(events)) {
+      neighbor->text_tr = std::to_string(newG + h);
+      neighbor->text_bl = std::to_string(newG);
+      neighbor->text_br = std::to_string(h);
+    }
+    if (neighbor != goalCell_) {
+      neighbor->vis = Cell::VisualizationState::OPEN_LIST;
+    }
+    record(events, neighbor);
+  };
+
+  // The start has its own edges, and subgoals may also lead straight to the goal.
+  if (index == startIndex_) {
+    for (const SubgoalGraph::Edge& edge : startEdges_) {
+      relax(edge.to, edge.cost);
+    }
+  } else {
+    for (const SubgoalGraph::Edge& edge : graph_->edges(index)) {
+      relax(edge.to, edge.cost);
+    }
+    auto toGoal = goalEdges_.find(index);
+    if (toGoal != goalEdges_.end()) {
+      relax(goalIndex_, toGoal->second);
+    }
+  }
+
+  return Status::RUNNING;
+}
+
+std::vector<std::shared_ptr<Grid::Cell>> SubgoalSearch::path() { return path_; }
+
+std::shared_ptr<const SubgoalGraph> SubgoalSearch::graph() const { return graph_; }
+
+bool SubgoalSearch::OpenEntry::operator<(const OpenEntry& other) const
+{
+  return f > other.f;
+}
+
+unsigned int SubgoalSearch::heuristic(int index) const
+{
+  return Heuristics::manhattan(
+      index % width_, index / width_, goalCell_->x, goalCell_->y, minCost_);
+}
+
+void SubgoalSearch::reconstructPath()
+{
+  // Collect the nodes of the path through the graph.
+  std::vector<int> nodes;
+  for (int i = goalIndex_; i != -1; i = parent_[i]) {
+    nodes.push_back(i);
+  }
+  std::reverse(nodes.begin(), nodes.end());
+
+  // Refine each edge into the grid moves between its ends.
+  path_.push_back(startCell_);
+  for (size_t i = 1; i < nodes.size(); i++) {
+    for (int index : graph_->refine(nodes[i - 1], nodes[i])) {
+      auto pathCell = grid_->grid[index];
+      if (pathCell != goalCell_) {
+        pathCell->vis = Cell::VisualizationState::PATH;
+      }
+      path_.push_back(pathCell);
+    }
+  }
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
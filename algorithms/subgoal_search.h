@@ -0,0 +1,122 @@
+#ifndef SUBGOAL_SEARCH_H
+#define SUBGOAL_SEARCH_H
+
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "../grid.h"
+#include "heuristics.h"
+#include "search_algorithm.h"
+#include "subgoal_graph.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * A* over a subgoal graph.
+ *
+ * The start and goal are linked into a prebuilt SubgoalGraph and A* runs over the
+ * sparse graph instead of the grid, so each step expands a whole subgoal. Once the goal
+ * is reached, every edge on the path is refined back into grid moves.
+ */
+class SubgoalSearch : public SearchAlgorithm {
+
+  public:
+
+  /**
+   * Construct a new SubgoalSearch.
+   *
+   * \param grid The grid to step through.
+   * \param start The start cell.
+   * \param goal The goal cell.
+   * \param graph A subgoal graph built over the grid, or nullptr to build one.
+   */
+  SubgoalSearch(std::shared_ptr<Grid> grid, const std::shared_ptr<Grid::Cell> start,
+      const std::shared_ptr<Grid::Cell> goal,
+      std::shared_ptr<const SubgoalGraph> graph = nullptr);
+
+  /**
+   * Destroy a SubgoalSearch.
+   */
+  ~SubgoalSearch();
+
+  /**
+   * Get the path found by the search algorithm.
+   * This function should only be called after the algorithm has finished.
+   * An empty vector will be returned if no path was found or the algorithm has not
+   * finished.
+   *
+   * \return A vector of cells that are in the path.
+   */
+  std::vector<std::shared_ptr<Grid::Cell>> path();
+
+  /**
+   * Get the subgoal graph being searched, with its size and build time.
+   *
+   * \return The graph, which was built by the constructor if none was given.
+   */
+  std::shared_ptr<const SubgoalGraph> graph() const;
+
+  protected:
+
+  /**
+   * Expand the next node of the subgoal graph.
+   *
+   * \param events If not null, an event is added to this for every cell that changed.
+   * \return RUNNING if there is more work to do, otherwise FOUND or NO_PATH.
+   */
+  Status expand(CellEventBuffer* events) override;
+
+  private:
+
+  /**
+   * An entry in the open list.
+   */
+  struct OpenEntry {
+    unsigned int f; // The total cost of the node.
+    unsigned int g; // The cost to get to the node when it was pushed.
+    int index; // The index of the node's cell.
+
+    bool operator<(const OpenEntry& other) const;
+  };
+
+  /**
+   * Get the heuristic cost from a cell to the goal.
+   *
+   * \param index The index of the cell.
+   * \return The heuristic cost.
+   */
+  unsigned int heuristic(int index) const;
+
+  /**
+   * Refine the path through the graph into grid moves.
+   */
+  void reconstructPath();
+
+  /*
+   * Data.
+   */
+
+  std::shared_ptr<Grid> grid_; // The grid to step through.
+  std::shared_ptr<Grid::Cell> startCell_; // The start cell.
+  std::shared_ptr<Grid::Cell> goalCell_; // The goal cell.
+  std::vector<std::shared_ptr<Grid::Cell>> path_; // The path found by the algorithm.
+  std::shared_ptr<const SubgoalGraph> graph_; // The subgoal graph.
+
+  int width_; // The width of the grid.
+  int startIndex_; // The index of the start cell.
+  int goalIndex_; // The index of the goal cell.
+  unsigned int minCost_; // The cheapest cost of entering any passable cell.
+
+  std::vector<SubgoalGraph::Edge> startEdges_; // The edges leaving the start.
+  std::unordered_map<int, unsigned int> goalEdges_; // Cost to the goal, by subgoal.
+
+  std::vector<unsigned int> g_; // The cost to get to each node.
+  std::vector<int> parent_; // The parent of each node, or -1.
+  std::vector<bool> closed_; // Whether each node has been expanded.
+  std::priority_queue<OpenEntry> open_; // The nodes to visit.
+};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,283 @@
+#include "theta_star.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using Cell = Grid::Cell;
+
+namespace {
+
+/**
+ * Format a cost for display in a cell corner.
+ *
+ * \param cost The cost.
+ * \return The cost with one decimal place.
+ */
+std::string formatCost(double cost)
+{
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(1) << cost;
+  return stream.str();
+}
+}
+
+namespace SearchAlgorithms {
+
+ThetaStar::ThetaStar(std::shared_ptr<Grid> grid, const std::shared_ptr<Cell> start,
+    const std::shared_ptr<Cell> goal, bool lazy)
+    : lazy_(lazy)
+{
+  // Init grid
+  this->grid_ = grid;
+  this->startCell_ = start;
+  this->goalCell_ = goal;
+  width_ = grid_->getWidth();
+  height_ = grid_->getHeight();
+  startIndex_ = start->y * width_ + start->x;
+  goalIndex_ = goal->y * width_ + goal->x;
+
+  // If the goal is walled off, fail before building any search state.
+  if (finishIfUnreachable(*grid_, startCell_, goalCell_)) {
+    return;
+  }
+
+  const int size = width_ * height_;
+  cost_.resize(size);
+  for (int i = 0; i < size; i++) {
+    auto cell = grid_->grid[i];
+    cost_[i] = cell->cost;
+    cell->link = nullptr;
+
+    // Reset visualization state
+    switch (cell->vis) {
+    case Cell::VisualizationState::PATH:
+    case Cell::VisualizationState::OPEN_LIST:
+    case Cell::VisualizationState::CLOSED_LIST:
+      cell->vis = Cell::VisualizationState::UNVISITED;
+    default:
+      break;
+    }
+  }
+
+  lineOfSight_.reset(new LineOfSight(*grid_));
+  minCost_ = Heuristics::cheapestCost(*grid_);
+  g_.assign(size, std::numeric_limits<double>::infinity());
+  parent_.assign(size, -1);
+  closed_.assign(size, false);
+  verified_.assign(size, true);
+  count().state(cost_);
+  count().state(g_);
+  count().state(parent_);
+  count().state(closed_);
+  count().state(verified_);
+
+  // Add start cell to open list
+  g_[startIndex_] = 0;
+  open_.push({ heuristic(startIndex_), 0, startIndex_ });
+  count().push(open_.size());
+}
+
+ThetaStar::~ThetaStar() { }
+
+SearchAlgorithm::Status ThetaStar::expand(CellEventBuffer* events)
+{
+  // Skip entries that were superseded by a cheaper path.
+  while (!open_.empty()
+      && (closed_[open_.top().index] || open_.top().g != g_[open_.top().index])) {
+    open_.pop();
+    count().stalePop();
+  }
+
+  // Check if the open list is empty
+  if (open_.empty()) {
+    return Status::NO_PATH; // No path was found
+  }
+
+  const int index = open_.top().index;
+  open_.pop();
+  auto cell = grid_->grid[index];
+
+  // Lazy Theta* checks the line to the parent now. If the cost went up, the cell goes
+  // back into the open list in its proper place.
+  if (!verified_[index]) {
+    verified_[index] = true;
+    if (verify(index)) {
+      open_.push({ g_[index] + heuristic(index), g_[index], index });
+      count().push(open_.size());
+      if (annotating(events)) {
+        cell->text_tr = formatCost(g_[index] + heuristic(index));
+        cell->text_bl = formatCost(g_[index]);
+      }
+      record(events, cell);
+      return Status::RUNNING;
+    }
+  }
+
+  // If the goal has been found, the path can be reconstructed.
+  // FOUND will be returned, indicating that the algorithm is finished.
+  if (index == goalIndex_) {
+    reconstructPath();
+    return Status::FOUND;
+  }
+
+  // Add the cell to the closed list.
+  closed_[index] = true;
+  if (cell != startCell_) {
+    cell->vis = Cell::VisualizationState::CLOSED_LIST;
+  }
+  record(events, cell);
+
+  /*
+   * Each neighbor can be reached either with a grid move from this cell or with a
+   * straight line from this cell's parent. Theta* traces the line straight away and
+   * keeps the cheaper of the two. Lazy Theta* assumes that the line is clear and costs
+   * no more than its length at the cheapest cell cost, and checks it later.
+   */
+
+  const int parent = parent_[index];
+  const int x = index % width_;
+  const int y = index / width_;
+  const int neighbors[4][2]
+      = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+  for (auto& n : neighbors) {
+    if (n[0] < 0 || n[0] >= width_ || n[1] < 0 || n[1] >= height_) {
+      continue;
+    }
+    const int neighbor = n[1] * width_ + n[0];
+    if (cost_[neighbor] == Cell::WALL_COST || closed_[neighbor]) {
+      continue;
+    }
+
+    double newG = g_[index] + cost_[neighbor];
+    int newParent = index;
+    bool verified = true;
+
+    if (parent != -1 && !lazy_) {
+      double lineCost;
+      sightChecks_++;
+      if (lineOfSight_->trace(parent, neighbor, lineCost)
+          && g_[parent] + lineCost < newG) {
+        newG = g_[parent] + lineCost;
+        newParent = parent;
+      }
+    } else if (parent != -1) {
+      newG = g_[parent]
+          + Heuristics::euclidean(
+              n[0], n[1], parent % width_, parent / width_, minCost_);
+      newParent = parent;
+      verified = false;
+    }
+
+    if (newG < g_[neighbor]) {
+      verified_[neighbor] = verified;
+      open(neighbor, newParent, newG, events);
+    }
+  }
+
+  return Status::RUNNING;
+}
+
+std::vector<std::shared_ptr<Grid::Cell>> ThetaStar::path() { return path_; }
+
+unsigned long ThetaStar::sightChecks() const { return sightChecks_; }
+
+bool ThetaStar::OpenEntry::operator<(const OpenEntry& other) const
+{
+  return f > other.f;
+}
+
+double ThetaStar::heuristic(int index) const
+{
+  return Heuristics::euclidean(
+      index % width_, index / width_, goalCell_->x, goalCell_->y, minCost_);
+}
+
+void ThetaStar::open(int index, int parent, double g, CellEventBuffer* events)
+{
+  if (g_[index] != std::numeric_limits<double>::infinity()) {
+    count().decreaseKey();
+  }
+  g_[index] = g;
+  parent_[index] = parent;
+  const double h = heuristic(index);
+  open_.push({ g + h, g, index });
+  count().push(open_.size());
+
+  auto cell = grid_->grid[index];
+  cell->link = grid_->grid[parent].get();
+  if (annotating(events)) {
+    cell->text_tr = formatCost(g + h);
+    cell->text_bl = formatCost(g);
+    cell->text_br = formatCost(h);
+  }
+  if (cell != goalCell_) {
+    cell->vis = Cell::VisualizationState::OPEN_LIST;
+  }
+  record(events, cell);
+}
+
+bool ThetaStar::verify(int index)
+{
+  const int parent = parent_[index];
+  double best = std::numeric_limits<double>::infinity();
+  int bestParent = -1;
+
+  double lineCost;
+  sightChecks_++;
+  if (lineOfSight_->trace(parent, index, lineCost)) {
+    best = g_[parent] + lineCost;
+    bestParent = parent;
+  }
+
+  // Fall back to the best neighbor that has already been expanded. There is always at
+  // least one, since the cell was opened from a neighbor.
+  const int x = index % width_;
+  const int y = index / width_;
+  const int neighbors[4][2]
+      = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+  for (auto& n : neighbors) {
+    if (n[0] < 0 || n[0] >= width_ || n[1] < 0 || n[1] >= height_) {
+      continue;
+    }
+    const int neighbor = n[1] * width_ + n[0];
+    if (closed_[neighbor] && g_[neighbor] + cost_[index] < best) {
+      best = g_[neighbor] + cost_[index];
+      bestParent = neighbor;
+    }
+  }
+
+  const bool worse = best > g_[index];
+  g_[index] = best;
+  parent_[index] = bestParent;
+  grid_->grid[index]->link = grid_->grid[bestParent].get();
+  return worse;
+}
+
+void ThetaStar::reconstructPath()
+{
+  // Collect the corners of the any-angle path.
+  std::vector<int> vertices;
+  for (int i = goalIndex_; i != -1; i = parent_[i]) {
+    vertices.push_back(i);
+  }
+  std::reverse(vertices.begin(), vertices.end());
+
+  // Fill in each segment with the cells that it crosses.
+  path_.push_back(startCell_);
+  for (size_t i = 1; i < vertices.size(); i++) {
+    for (int index : lineOfSight_->cells(vertices[i - 1], vertices[i])) {
+      auto pathCell = grid_->grid[index];
+      if (pathCell != goalCell_) {
+        pathCell->vis = Cell::VisualizationState::PATH;
+      }
+      path_.push_back(pathCell);
+    }
+  }
+
+  std::cout << "Path found!" << std::endl;
+}
+} // namespace SearchAlgorithms
\ No newline at end of file
@@ -0,0 +1,155 @@
+#ifndef THETA_STAR_H
+#define THETA_STAR_H
+
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "../grid.h"
+#include "heuristics.h"
+#include "line_of_sight.h"
+#include "search_algorithm.h"
+
+namespace SearchAlgorithms {
+
+/**
+ * Theta* and Lazy Theta* any-angle search.
+ *
+ * Theta* works like A*, but a cell may take its parent's parent as its own parent when
+ * there is a clear line between them, so paths are made of straight segments at any
+ * angle rather than moves along the grid axes. A segment costs its length times the
+ * average cost of the cells that it crosses.
+ *
+ * Lazy Theta* defers the line-of-sight check. A cell is first given its parent's parent
+ * at an optimistic cost, and the line is only traced once the cell is taken from the
+ * open list. If the line is blocked or dearer than expected, the cell falls back to its
+ * best expanded neighbor and goes back into the open list with the corrected cost.
+ *
+ * Each cell's parent is exposed through `Grid::Cell::link`, so that the graphics area
+ * can draw the segments.
+ */
+class ThetaStar : public SearchAlgorithm {
+
+  public:
+
+  /**
+   * Construct a new ThetaStar.
+   *
+   * \param grid The grid to step through.
+   * \param start The start cell.
+   * \param goal The goal cell.
+   * \param lazy True to run Lazy Theta*.
+   */
+  ThetaStar(std::shared_ptr<Grid> grid, const std::shared_ptr<Grid::Cell> start,
+      const std::shared_ptr<Grid::Cell> goal, bool lazy = false);
+
+  /**
+   * Destroy a ThetaStar.
+   */
+  ~ThetaStar();
+
+  /**
+   * Get the path found by the search algorithm.
+   * The segments of the any-angle path are filled in with the cells that they cross,
+   * so consecutive cells are always neighbors.
+   * This function should only be called after the algorithm has finished.
+   * An empty vector will be returned if no path was found or the algorithm has not
+   * finished.
+   *
+   * \return A vector of cells that are in the path.
+   */
+  std::vector<std::shared_ptr<Grid::Cell>> path();
+
+  /**
+   * Get the number of line-of-sight checks made so far.
+   *
+   * \return The number of lines traced between a cell and a candidate parent.
+   */
+  unsigned long sightChecks() const;
+
+  protected:
+
+  /**
+   * Take the next cell from the open list and expand it (or, for Lazy Theta*, put it
+   * back with a corrected cost).
+   *
+   * \param events If not null, an event is added to this for every cell that changed.
+   * \return RUNNING if there is more work to do, otherwise FOUND or NO_PATH.
+   */
+  Status expand(CellEventBuffer* events) override;
+
+  private:
+
+  /**
+   * An entry in the open list.
+   */
+  struct OpenEntry {
+    double f; // The total cost of the cell.
+    double g; // The cost to get to the cell when it was pushed.
+    int index; // The index of the cell.
+
+    bool operator<(const OpenEntry& other) const;
+  };
+
+  /**
+   * Get the heuristic cost from a cell to the goal.
+   *
+   * \param index The index of the cell.
+   * \return The heuristic cost.
+   */
+  double heuristic(int index) const;
+
+  /**
+   * Give a cell a new parent and put it in the open list.
+   *
+   * \param index The index of the cell.
+   * \param parent The index of the new parent.
+   * \param g The new cost to get to the cell.
+   * \param events The event buffer, if events are being collected.
+   */
+  void open(int index, int parent, double g, CellEventBuffer* events);
+
+  /**
+   * Check the line from a cell to its parent, as Lazy Theta* defers this until the cell
+   * is expanded. If the line is blocked or dearer than assumed, the cell is given the
+   * cheaper of the line and its best expanded neighbor.
+   *
+   * \param index The index of the cell.
+   * \return True if the cost of the cell went up.
+   */
+  bool verify(int index);
+
+  /**
+   * Build the path from the parents of the goal and print its statistics.
+   */
+  void reconstructPath();
+
+  /*
+   * Data.
+   */
+
+  std::shared_ptr<Grid> grid_; // The grid to step through.
+  std::shared_ptr<Grid::Cell> startCell_; // The start cell.
+  std::shared_ptr<Grid::Cell> goalCell_; // The goal cell.
+  std::vector<std::shared_ptr<Grid::Cell>> path_; // The path found by the algorithm.
+  bool lazy_; // Whether line-of-sight checks are deferred.
+
+  int width_; // The width of the grid.
+  int height_; // The height of the grid.
+  int startIndex_; // The index of the start cell.
+  int goalIndex_; // The index of the goal cell.
+  double minCost_; // The cheapest cost of entering any passable cell.
+
+  std::unique_ptr<LineOfSight> lineOfSight_; // Line-of-sight checks over the grid.
+  std::vector<unsigned int> cost_; // A snapshot of the cell costs.
+  std::vector<double> g_; // The cost to get to each cell.
+  std::vector<int> parent_; // The parent of each cell, or -1.
+  std::vector<bool> closed_; // Whether each cell has been expanded.
+  std::vector<bool> verified_; // Whether each cell's line to its parent is checked.
+  std::priority_queue<OpenEntry> open_; // The cells to visit.
+
+  unsigned long sightChecks_ = 0; // The number of lines traced.
+};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "baseline.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int BASELINE_REPETITIONS
+    = 5; // The repetitions of each benchmark when a baseline is used, by default.
+
+/*
+ * Baseline format.
+ *
+ * A baseline is a text file with one line per benchmark: its name and its CPU time per
+ * iteration in nanoseconds, separated by whitespace. Benchmark names never contain
+ * whitespace.
+ */
+
+/**
+ * Passes results on to the console while keeping the CPU time of every run.
+ */
+class RecordingReporter : public benchmark::ConsoleReporter {
+  public:
+
+  void ReportRuns(const std::vector<Run>& reports) override
+  {
+    for (const Run& run : reports) {
+      if (run.run_type == Run::RT_Iteration && !run.error_occurred) {
+        times[run.benchmark_name()].push_back(run.GetAdjustedCPUTime()
+            / benchmark::GetTimeUnitMultiplier(run.time_unit) * 1e9);
+      }
+    }
+    ConsoleReporter::ReportRuns(reports);
+  }
+
+  std::map<std::string, std::vector<double>>
+      times; // The CPU times of each benchmark's runs (ns).
+};
+
+/**
+ * Get the median of some times.
+ *
+ * \param times The times, which must not be empty.
+ * \return The median time.
+ */
+double median(std::vector<double> times)
+{
+  std::sort(times.begin(), times.end());
+  const size_t middle = times.size() / 2;
+  return times.size() % 2 == 1 ? times[middle]
+                               : (times[middle - 1] + times[middle]) / 2;
+}
+
+/**
+ * Take a flag of the form `--name=value` out of the arguments.
+ *
+ * \param argc The number of arguments, reduced if the flag is found.
+ * \param argv The arguments, with the flag removed if it is found.
+ * \param name The name of the flag, including the leading dashes.
+ * \param value Set to the value of the flag if it is found.
+ * \return True if the flag was found.
+ */
+bool takeFlag(int& argc, char* argv[], const std::string& name, std::string& value)
+{
+  const std::string prefix = name + "=";
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+    if (argument.compare(0, prefix.size(), prefix) == 0) {
+      value = argument.substr(prefix.size());
+      std::copy(argv + i + 1, argv + argc, argv + i);
+      argc--;
+      return true;
+    }
+  }
+  return false;
+}
+}
+
+int runMicrobenchmarks(int argc, char* argv[])
+{
+  // Take out the baseline flags before Google Benchmark sees them.
+  std::string savePath, baselinePath, thresholdText;
+  takeFlag(argc, argv, "--save-baseline", savePath);
+  takeFlag(argc, argv, "--baseline", baselinePath);
+  double threshold = 10;
+  if (takeFlag(argc, argv, "--threshold", thresholdText)) {
+    char* end;
+    threshold = std::strtod(thresholdText.c_str(), &end);
+    if (*end != '\0' || threshold < 0) {
+      std::cerr << "Invalid threshold: " << thresholdText << std::endl;
+      return 2;
+    }
+  }
+
+  /*
+   * A single run of a slow benchmark is too noisy to compare, so unless the repetitions
+   * are given, a baseline is saved and compared using the median of several runs.
+   */
+
+  const std::string flag = "--benchmark_repetitions";
+  bool repeated = false;
+  for (int i = 1; i < argc; i++) {
+    repeated = repeated || std::string(argv[i]).compare(0, flag.size(), flag) == 0;
+  }
+  std::vector<char*> arguments(argv, argv + argc);
+  std::string repetitions = flag + "=" + std::to_string(BASELINE_REPETITIONS);
+  if (!repeated && (!savePath.empty() || !baselinePath.empty())) {
+    arguments.push_back(&repetitions[0]);
+  }
+  int count = (int)arguments.size();
+  arguments.push_back(nullptr);
+
+  benchmark::Initialize(&count, arguments.data());
+  if (benchmark::ReportUnrecognizedArguments(count, arguments.data())) {
+    return 2;
+  }
+
+  // Read the baseline first, so that a bad path is reported before anything runs.
+  std::map<std::string, double> baseline;
+  if (!baselinePath.empty()) {
+    std::ifstream in(baselinePath);
+    std::string name;
+    double time;
+    while (in >> name >> time) {
+      baseline[name] = time;
+    }
+    if (!in.eof() || baseline.empty()) {
+      std::cerr << "Could not read a baseline from " << baselinePath << std::endl;
+      return 2;
+    }
+  }
+
+  RecordingReporter reporter;
+  benchmark::RunSpecifiedBenchmarks(&reporter);
+  benchmark::Shutdown();
+
+  std::map<std::string, double> results;
+  for (const auto& entry : reporter.times) {
+    results[entry.first] = median(entry.second);
+  }
+
+  // Save the baseline.
+  if (!savePath.empty()) {
+    std::ofstream out(savePath);
+    out << std::setprecision(6);
+    for (const auto& result : results) {
+      out << result.first << " " << result.second << "\n";
+    }
+    if (!out) {
+      std::cerr << "Could not write a baseline to " << savePath << std::endl;
+      return 2;
+    }
+  }
+
+  // Compare against the baseline, flagging anything that got too slow.
+  if (baseline.empty()) {
+    return 0;
+  }
+  int slower = 0;
+  std::cout << "\nComparison with " << baselinePath << " (threshold " << threshold
+            << "%):\n";
+  for (const auto& result : results) {
+    auto base = baseline.find(result.first);
+    if (base == baseline.end()) {
+      std::cout << std::left << std::setw(40) << result.first << " not in baseline\n";
+      continue;
+    }
+    const double change = (result.second / base->second - 1) * 100;
+    const bool flagged = change > threshold;
+    slower += flagged;
+    std::cout << std::left << std::setw(40) << result.first << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << base->second << " ns"
+              << std::setw(12) << result.second << " ns" << std::showpos << std::setw(9)
+              << change << "%" << std::noshowpos << (flagged ? "  SLOWER" : "") << "\n";
+  }
+  std::cout << slower << " benchmark(s) slower than the threshold." << std::endl;
+  return slower > 0 ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef BASELINE_H
+#define BASELINE_H
+
+/**
+ * Run the registered microbenchmarks, optionally against a saved baseline.
+ *
+ * Google Benchmark's own flags are accepted, along with:
+ *
+ *   --save-baseline=FILE   Save the CPU time per iteration of every benchmark.
+ *   --baseline=FILE        Compare every benchmark against a saved baseline.
+ *   --threshold=PERCENT    How much slower than the baseline a benchmark may get
+ *                          before it is flagged (default 10).
+ *
+ * When a benchmark is repeated, its median is saved and compared. Unless
+ * `--benchmark_repetitions` is given, every benchmark is repeated 5 times when a
+ * baseline is saved or compared.
+ *
+ * \param argc The number of arguments.
+ * \param argv The arguments.
+ * \return 0 on success, 1 if a benchmark is slower than the baseline allows, or 2 if
+ *         the arguments or files are invalid.
+ */
+int runMicrobenchmarks(int argc, char* argv[]);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+/*
+ * Microbenchmarks of repainting cells in the graphics area.
+ *
+ * Cell graphics are only updated through `GraphicsArea::updateCells()`, which repaints
+ * each cell named in a batch of events once with `updateCellGraphics()`. Every event
+ * in the batches here names a different cell, so the time per item is the time per
+ * `updateCellGraphics()` call. The grids are smaller than in the search benchmarks,
+ * since every cell has a handful of graphics items. Qt runs offscreen unless told
+ * otherwise, so no display is needed. See `baseline.h` for comparing a run against a
+ * saved baseline.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <QApplication>
+
+#include "../algorithms/cell_events.h"
+#include "../widgets/graphics_area.h"
+#include "baseline.h"
+
+using Cell = Grid::Cell;
+
+namespace {
+
+/**
+ * Repaint every cell of a grid, alternating between the open and closed states.
+ */
+void updateCellGraphics(benchmark::State& state)
+{
+  const int size = state.range(0);
+  GraphicsArea area(0, 0);
+  area.initGrid(size, size);
+  area.drawGrid();
+  area.updateInteractionMode(false);
+  std::shared_ptr<Grid> grid = area.getGrid();
+
+  // Record one event per cell, leaving the start and goal cells alone.
+  SearchAlgorithms::CellEventBuffer events(size);
+  for (int i = 1; i < size * size - 1; i++) {
+    events.push(*grid->grid[i]);
+  }
+
+  bool open = false;
+  for (auto _ : state) {
+    state.PauseTiming();
+    open = !open;
+    for (int i = 1; i < size * size - 1; i++) {
+      grid->grid[i]->vis = open ? Cell::VisualizationState::OPEN_LIST
+                                : Cell::VisualizationState::CLOSED_LIST;
+    }
+    state.ResumeTiming();
+    area.updateCells(events);
+  }
+  state.SetItemsProcessed(state.iterations() * events.size());
+}
+BENCHMARK(updateCellGraphics)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(128)
+    ->Unit(benchmark::kMillisecond);
+}
+
+int main(int argc, char* argv[])
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+  QApplication application(argc, argv);
+  return runMicrobenchmarks(argc, argv);
+}
\ No newline at end of file
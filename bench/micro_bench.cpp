@@ -0,0 +1,167 @@
+/*
+ * Microbenchmarks of the primitives that dominate search profiles.
+ *
+ * Every benchmark runs on square grids of several sizes, since cache behaviour changes
+ * as the grid outgrows each level of cache. Cells are visited in a shuffled order so
+ * that the benchmarks don't measure a prefetcher-friendly sweep. See `baseline.h` for
+ * comparing a run against a saved baseline. Build with CMAKE_BUILD_TYPE=Release, or the
+ * numbers will mostly measure unoptimized standard library code.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../algorithms/astar.h"
+#include "../grid.h"
+#include "baseline.h"
+
+using Cell = Grid::Cell;
+using SearchAlgorithms::HeadlessAStar;
+
+namespace {
+
+constexpr unsigned int SEED = 1; // The seed of every shuffle, so runs are comparable.
+
+/**
+ * Register a benchmark at each grid size.
+ *
+ * \param benchmark The benchmark.
+ */
+void gridSizes(benchmark::internal::Benchmark* benchmark)
+{
+  benchmark->Arg(64)->Arg(256)->Arg(1024);
+}
+
+/**
+ * Register a benchmark at each grid size that fills a whole open list, which stops
+ * short of the largest grid so that one iteration doesn't take seconds.
+ *
+ * \param benchmark The benchmark.
+ */
+void openListSizes(benchmark::internal::Benchmark* benchmark)
+{
+  benchmark->Arg(64)->Arg(256)->Arg(512);
+}
+
+/**
+ * Get the cells of a grid in a shuffled order.
+ *
+ * \param grid The grid.
+ * \return Every cell of the grid, shuffled.
+ */
+std::vector<std::shared_ptr<Cell>> shuffledCells(const Grid& grid)
+{
+  std::vector<std::shared_ptr<Cell>> cells(
+      grid.grid, grid.grid + grid.getWidth() * grid.getHeight());
+  std::shuffle(cells.begin(), cells.end(), std::mt19937(SEED));
+  return cells;
+}
+
+/**
+ * Look up cells by their coordinates.
+ */
+void getCell(benchmark::State& state)
+{
+  const int size = state.range(0);
+  Grid grid(size, size);
+  const std::vector<std::shared_ptr<Cell>> cells = shuffledCells(grid);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    const std::shared_ptr<Cell>& cell = cells[i];
+    benchmark::DoNotOptimize(grid.getCell(cell->x, cell->y));
+    i = i + 1 == cells.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(getCell)->Apply(gridSizes);
+
+/**
+ * Get the neighbors of cells, as every expansion does.
+ */
+void getNeighbors(benchmark::State& state)
+{
+  const int size = state.range(0);
+  Grid grid(size, size);
+  const std::vector<std::shared_ptr<Cell>> cells = shuffledCells(grid);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grid.getNeighbors(cells[i]));
+    i = i + 1 == cells.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(getNeighbors)->Apply(gridSizes);
+
+/**
+ * Give every cell of a grid A* search data with a random f cost.
+ * The cells' search data is freed by the A* the grid is given to.
+ *
+ * \param grid The grid.
+ */
+void randomCosts(Grid& grid)
+{
+  std::mt19937 random(SEED);
+  std::uniform_int_distribution<unsigned int> cost(0, 4 * grid.getWidth());
+  for (int i = 0; i < grid.getWidth() * grid.getHeight(); i++) {
+    const std::shared_ptr<Cell>& cell = grid.grid[i];
+    if (cell->searchData == nullptr) {
+      cell->searchData = new HeadlessAStar::SearchData;
+    }
+    ((HeadlessAStar::SearchData*)cell->searchData)->f = cost(random);
+  }
+}
+
+/**
+ * Push every cell of a grid onto A*'s open list, then pop them all.
+ */
+void openListPushPop(benchmark::State& state)
+{
+  const int size = state.range(0);
+  std::shared_ptr<Grid> grid = std::make_shared<Grid>(size, size);
+  HeadlessAStar astar(grid, grid->grid[0], grid->grid[size * size - 1]);
+  randomCosts(*grid);
+  astar.pQueue.pop();
+  const std::vector<std::shared_ptr<Cell>> cells = shuffledCells(*grid);
+
+  for (auto _ : state) {
+    for (const std::shared_ptr<Cell>& cell : cells) {
+      astar.pQueue.push(cell);
+    }
+    while (!astar.pQueue.empty()) {
+      benchmark::DoNotOptimize(astar.pQueue.top());
+      astar.pQueue.pop();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * cells.size());
+}
+BENCHMARK(openListPushPop)->Apply(openListSizes)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Compare pairs of cells the way A*'s open list orders them.
+ */
+void compareCells(benchmark::State& state)
+{
+  const int size = state.range(0);
+  std::shared_ptr<Grid> grid = std::make_shared<Grid>(size, size);
+  HeadlessAStar astar(grid, grid->grid[0], grid->grid[size * size - 1]);
+  randomCosts(*grid);
+  const std::vector<std::shared_ptr<Cell>> cells = shuffledCells(*grid);
+  const HeadlessAStar::CompareCells compare;
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(compare(cells[i], cells[i + 1]));
+    i = i + 2 >= cells.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(compareCells)->Apply(gridSizes);
+}
+
+int main(int argc, char* argv[]) { return runMicrobenchmarks(argc, argv); }
\ No newline at end of file
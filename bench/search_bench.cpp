@@ -0,0 +1,673 @@
+/*
+ * A benchmark of the search engines that runs without the visualizer.
+ *
+ * Every engine searches the same map, either generated from a seed or loaded from a
+ * trace, a grid snapshot or a Moving AI map. A trace or snapshot is searched between
+ * its start and goal cells, and any other map across its largest connected region.
+ * Only the search itself is timed: copying the map and constructing the engine
+ * (including building a subgoal graph) are not. Each engine runs some warmup
+ * searches, then the timed repetitions, of which the median is reported, along with
+ * the counters of the last timed search (including the peak size of the open list,
+ * which is 0 if the build doesn't have SEARCH_COUNTERS set). Before any of that, each
+ * engine also searches once in a forked child process, which reports how far the
+ * search raised its peak memory use.
+ *
+ * An expansion is one step of an engine: one cell for most engines, but a whole
+ * frontier for BitBFS and a whole search for HDA*, whose expansions are counted from
+ * its worker threads instead.
+ */
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../algorithms/engine_table.h"
+#include "../algorithms/hda_star.h"
+#include "../grid.h"
+#include "../grid_snapshot.h"
+#include "../map_generator.h"
+#include "../moving_ai.h"
+#include "../profiler.h"
+#include "../search_trace.h"
+
+using namespace SearchAlgorithms;
+using Cell = Grid::Cell;
+using State = Grid::Cell::VisualizationState;
+using Status = SearchAlgorithm::Status;
+using Clock = std::chrono::steady_clock;
+using Engine = NamedEngine;
+
+namespace {
+
+constexpr unsigned int MIN_COST = 1; // The cheapest cell, as in the visualizer.
+constexpr unsigned int MAX_COST = 9; // The most expensive cell, as in the visualizer.
+constexpr int JSON_DECIMALS = 6; // The decimal places of the numbers in the JSON.
+
+/**
+ * The options of a benchmark.
+ */
+struct Options {
+  MapGenerator::Settings generator; // What to generate, if no map is loaded.
+  std::string grid; // The trace, snapshot or Moving AI map to load, if any.
+  std::vector<std::string> engines; // The engines to run.
+  int warmup = 1; // The number of untimed searches before the timed ones.
+  int repetitions = 5; // The number of timed searches.
+  std::string json; // The file to write the results to as JSON, if any.
+  std::string profile; // The file to write a Chrome trace of the searches to, if any.
+};
+
+/**
+ * A map to search.
+ */
+struct Map {
+  int width; // The width of the map.
+  int height; // The height of the map.
+  std::vector<unsigned int> costs; // The cost of every cell.
+  int start; // The index of the start cell.
+  int goal; // The index of the goal cell.
+  std::string source; // Where the map came from.
+};
+
+/**
+ * A map being searched by one engine.
+ */
+struct Search {
+  std::shared_ptr<Grid> grid; // A fresh copy of the map.
+  std::shared_ptr<SearchAlgorithm> engine; // The engine searching it.
+};
+
+/**
+ * The results of benchmarking one engine.
+ */
+struct Result {
+  std::string engine; // The name of the engine.
+  std::string status; // How the search ended, or why it was skipped.
+  unsigned long expansions = 0; // The number of expansions of a search.
+  double milliseconds = 0; // The median time of a search.
+  long searchRssKb = 0; // The memory the search used, from searchRssKb().
+  double pathCost = 0; // The cost of the path found.
+  SearchCounters counters; // What the last timed search did.
+};
+
+/**
+ * Silences `std::cout` while it is alive, since the engines report their results there.
+ */
+class QuietOutput {
+  public:
+
+  QuietOutput()
+      : saved_(std::cout.rdbuf(nullptr))
+  {
+  }
+
+  ~QuietOutput()
+  {
+    std::cout.rdbuf(saved_);
+    std::cout.clear();
+  }
+
+  private:
+
+  std::streambuf* saved_; // The buffer that `std::cout` wrote to.
+};
+
+/**
+ * Print how to use the benchmark.
+ *
+ * \param name The name the benchmark was run as.
+ */
+void usage(const char* name)
+{
+  std::cerr
+      << "Usage: " << name << " [options]\n"
+      << "  --layout L       Layout of a generated map: obstacles, maze, noise, rooms\n"
+      << "                   or city (default obstacles).\n"
+      << "  --width N        Width of a generated map (default 256).\n"
+      << "  --height N       Height of a generated map (default 256).\n"
+      << "  --density P      Fraction of a generated map that is walls, or of a\n"
+      << "                   city's blocks that are built up (default 0.2). Also\n"
+      << "                   --walls.\n"
+      << "  --seed N         Seed of a generated map (default 1).\n"
+      << "  --costs C        Costs of generated obstacles or noise: uniform or random\n"
+      << "                   (default uniform).\n"
+      << "  --grid FILE      Search the map of a saved trace, a .grid snapshot or a\n"
+      << "                   Moving AI .map instead.\n"
+      << "  --engines LIST   Comma-separated engines to run (default all).\n"
+      << "  --warmup N       Untimed searches per engine (default 1).\n"
+      << "  --reps N         Timed searches per engine (default 5).\n"
+      << "  --json FILE      Also write the results as JSON ('-' for stdout, in which\n"
+      << "                   case the table goes to stderr).\n"
+      << "  --profile FILE   Write the timings of every search as a Chrome trace.\n";
+}
+
+/**
+ * Parse the command line.
+ *
+ * \param argc The number of arguments.
+ * \param argv The arguments.
+ * \param options Set to the options given.
+ * \return False if the command line is invalid.
+ */
+bool parse(int argc, char* argv[], Options& options)
+{
+  for (int i = 1; i < argc; i++) {
+    const std::string option = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const std::string value = argv[++i];
+
+    char* end = nullptr;
+    MapGenerator::Settings& generator = options.generator;
+    if (option == "--layout") {
+      if (!MapGenerator::layoutNamed(value, generator.layout)) {
+        return false;
+      }
+    } else if (option == "--width") {
+      generator.width = (int)std::strtol(value.c_str(), &end, 10);
+    } else if (option == "--height") {
+      generator.height = (int)std::strtol(value.c_str(), &end, 10);
+    } else if (option == "--density" || option == "--walls") {
+      generator.density = std::strtod(value.c_str(), &end);
+    } else if (option == "--seed") {
+      generator.seed = (unsigned int)std::strtoul(value.c_str(), &end, 10);
+    } else if (option == "--costs") {
+      if (value != "uniform" && value != "random") {
+        return false;
+      }
+      generator.maxCost = value == "random" ? MAX_COST : MIN_COST;
+    } else if (option == "--grid") {
+      options.grid = value;
+    } else if (option == "--engines") {
+      std::stringstream list(value);
+      std::string engine;
+      options.engines.clear();
+      while (std::getline(list, engine, ',')) {
+        options.engines.push_back(engine);
+      }
+    } else if (option == "--warmup") {
+      options.warmup = (int)std::strtol(value.c_str(), &end, 10);
+    } else if (option == "--reps") {
+      options.repetitions = (int)std::strtol(value.c_str(), &end, 10);
+    } else if (option == "--json") {
+      options.json = value;
+    } else if (option == "--profile") {
+      options.profile = value;
+    } else {
+      return false;
+    }
+
+    // A number must make up the whole value.
+    if (end != nullptr && *end != '\0') {
+      return false;
+    }
+  }
+
+  const MapGenerator::Settings& generator = options.generator;
+  return generator.width > 0 && generator.height > 0 && generator.density >= 0
+      && generator.density <= 1 && options.warmup >= 0 && options.repetitions > 0;
+}
+
+/**
+ * Copy the size and costs of a grid into a map.
+ *
+ * \param grid The grid.
+ * \param map Set to the grid's size and costs.
+ */
+void copyCosts(const Grid& grid, Map& map)
+{
+  map.width = grid.getWidth();
+  map.height = grid.getHeight();
+  map.costs.resize(map.width * map.height);
+  for (int i = 0; i < map.width * map.height; i++) {
+    map.costs[i] = grid.grid[i]->cost;
+  }
+}
+
+/**
+ * Generate a map.
+ * The search runs between the first and last cells of its largest connected region.
+ *
+ * \param options The options of the benchmark.
+ * \param map Set to the map.
+ * \return False if no two passable cells of the map are connected.
+ */
+bool generate(const Options& options, Map& map)
+{
+  const MapGenerator::Map generated = MapGenerator::generate(options.generator);
+  copyCosts(*generated.grid, map);
+  map.start = generated.start;
+  map.goal = generated.goal;
+  map.source = "generated " + MapGenerator::describe(options.generator);
+  return map.start >= 0 && map.goal >= 0;
+}
+
+/**
+ * Load the map of a saved trace, a grid snapshot or a Moving AI map.
+ * A Moving AI map, or a snapshot saved without a start and goal, is searched across
+ * its largest connected region.
+ *
+ * \param path The path of the file.
+ * \param map Set to the map.
+ * \return False if the file can't be loaded or has no start or goal cell.
+ */
+bool load(const std::string& path, Map& map)
+{
+  map.source = path;
+  std::shared_ptr<Grid> grid;
+  map.start = map.goal = -1;
+  if (MovingAI::isMapPath(path)) {
+    if (!MovingAI::loadMap(path, grid)) {
+      return false;
+    }
+  } else if (GridSnapshot::isSnapshotPath(path)) {
+    GridSnapshot snapshot;
+    if (!snapshot.open(path)) {
+      return false;
+    }
+    grid = snapshot.grid();
+    map.start = snapshot.start();
+    map.goal = snapshot.goal();
+  }
+  if (grid != nullptr) {
+    copyCosts(*grid, map);
+    if (map.start == -1 || map.goal == -1) {
+      grid->largestRegionEnds(map.start, map.goal);
+    }
+    return map.start >= 0 && map.goal >= 0;
+  }
+
+  SearchTrace trace;
+  if (!trace.load(path)) {
+    return false;
+  }
+
+  std::vector<State> states;
+  trace.seek(0, states);
+  map.width = trace.width();
+  map.height = trace.height();
+  map.costs = trace.costs();
+  map.start = map.goal = -1;
+  for (size_t i = 0; i < states.size(); i++) {
+    if (states[i] == State::START) {
+      map.start = (int)i;
+    } else if (states[i] == State::GOAL) {
+      map.goal = (int)i;
+    }
+  }
+  return map.start >= 0 && map.goal >= 0;
+}
+
+/**
+ * Set up an engine on a fresh copy of a map.
+ *
+ * \param map The map to search.
+ * \param engine The engine to search it with.
+ * \return The search, whose engine is nullptr if it can't search the map.
+ */
+Search prepare(const Map& map, const Engine& engine)
+{
+  Search search;
+  search.grid = std::make_shared<Grid>(map.width, map.height);
+  for (int i = 0; i < map.width * map.height; i++) {
+    const std::shared_ptr<Cell>& cell = search.grid->grid[i];
+    search.grid->setCost(cell, map.costs[i]);
+    if (map.costs[i] == Cell::WALL_COST) {
+      cell->vis = State::WALL;
+    }
+  }
+  search.grid->grid[map.start]->vis = State::START;
+  search.grid->grid[map.goal]->vis = State::GOAL;
+
+  QuietOutput quiet;
+  search.engine = engine.create(search.grid, search.grid->grid[map.start],
+      search.grid->grid[map.goal], false);
+  return search;
+}
+
+/**
+ * Get the number of expansions a finished search made.
+ *
+ * \param engine The engine that searched.
+ * \return The number of expansions.
+ */
+unsigned long expansions(const SearchAlgorithm& engine)
+{
+  const HDAStar* hda = dynamic_cast<const HDAStar*>(&engine);
+  if (hda == nullptr) {
+    return engine.expansions();
+  }
+  unsigned long total = 0;
+  for (const HDAStar::ThreadStats& stats : hda->threadStats()) {
+    total += stats.expansions;
+  }
+  return total;
+}
+
+/**
+ * Get the peak memory use of the process.
+ *
+ * \return The peak resident set size (KiB).
+ */
+long peakRssKb()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+/**
+ * Find how much memory a search uses, by running it in a child process.
+ * A forked child's peak starts from what it has resident when it is forked, rather
+ * than from the peak of the benchmark so far, so its growth covers only the memory
+ * the engine and its search use.
+ *
+ * \param map The map to search.
+ * \param engine The engine to search it with.
+ * \return The growth of the child's peak resident set size (KiB), including the copy
+ *         of the map and the engine's construction, or 0 if it couldn't be measured.
+ */
+long searchRssKb(const Map& map, const Engine& engine)
+{
+  int pipeEnds[2];
+  if (pipe(pipeEnds) != 0) {
+    return 0;
+  }
+  std::cout.flush();
+  std::cerr.flush();
+  const pid_t child = fork();
+  if (child == 0) {
+    close(pipeEnds[0]);
+    const long before = peakRssKb();
+    {
+      Search search = prepare(map, engine);
+      QuietOutput quiet;
+      if (search.engine != nullptr) {
+        search.engine->runToCompletion();
+      }
+    }
+    const long growth = peakRssKb() - before;
+    const bool written = write(pipeEnds[1], &growth, sizeof(growth)) == sizeof(growth);
+    _exit(written ? 0 : 1);
+  }
+
+  close(pipeEnds[1]);
+  long growth = 0;
+  if (child < 0 || read(pipeEnds[0], &growth, sizeof(growth)) != sizeof(growth)) {
+    growth = 0;
+  }
+  close(pipeEnds[0]);
+  int status = 0;
+  if (child > 0) {
+    waitpid(child, &status, 0);
+  }
+  return growth;
+}
+
+/**
+ * Benchmark one engine.
+ *
+ * \param map The map to search.
+ * \param engine The engine to benchmark.
+ * \param options The options of the benchmark.
+ * \return The results.
+ */
+Result benchmark(const Map& map, const Engine& engine, const Options& options)
+{
+  Result result;
+  result.engine = engine.name;
+
+  std::vector<double> times;
+  for (int run = 0; run < options.warmup + options.repetitions; run++) {
+    Search search = prepare(map, engine);
+    if (search.engine == nullptr) {
+      result.status = "not applicable";
+      return result;
+    }
+
+    Status status;
+    Clock::time_point begin, end;
+    {
+      QuietOutput quiet;
+      begin = Clock::now();
+      status = search.engine->runToCompletion();
+      end = Clock::now();
+    }
+
+    if (run >= options.warmup) {
+      times.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+    }
+    result.status = status == Status::FOUND ? "found" : "no path";
+    result.expansions = expansions(*search.engine);
+    result.pathCost = pathCost(search.engine->path());
+    result.counters = search.engine->counters();
+  }
+
+  std::sort(times.begin(), times.end());
+  const size_t middle = times.size() / 2;
+  result.milliseconds = times.size() % 2 == 1
+      ? times[middle]
+      : (times[middle - 1] + times[middle]) / 2;
+  return result;
+}
+
+/**
+ * Get the expansions per second of a result.
+ *
+ * \param result The result.
+ * \return The expansions per second, or 0 if the search took no measurable time.
+ */
+double expansionsPerSecond(const Result& result)
+{
+  return result.milliseconds > 0 ? result.expansions * 1000.0 / result.milliseconds : 0;
+}
+
+/**
+ * Get the time per expansion of a result.
+ *
+ * \param result The result.
+ * \return The time per expansion (ns), or 0 if there were no expansions.
+ */
+double nanosecondsPerExpansion(const Result& result)
+{
+  return result.expansions > 0 ? result.milliseconds * 1e6 / result.expansions : 0;
+}
+
+/**
+ * Print the results as a table.
+ *
+ * \param out The stream to print to.
+ * \param map The map that was searched.
+ * \param options The options of the benchmark.
+ * \param results The results of every engine.
+ */
+void printTable(std::ostream& out, const Map& map, const Options& options,
+    const std::vector<Result>& results)
+{
+  out << "Map: " << map.source << "\n"
+      << "Median of " << options.repetitions << " searches after " << options.warmup
+      << " warmup\n\n";
+
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << std::left << std::setw(12) << "engine" << std::setw(16) << "status"
+      << std::right << std::setw(12) << "expansions" << std::setw(11) << "ms"
+      << std::setw(13) << "exp/s" << std::setw(10) << "ns/exp" << std::setw(11)
+      << "peak open" << std::setw(15) << "search RSS KiB" << std::setw(11)
+      << "path cost" << "\n";
+
+  out << std::fixed;
+  for (const Result& result : results) {
+    out << std::left << std::setw(12) << result.engine << std::setw(16)
+        << result.status << std::right;
+    if (result.status == "not applicable") {
+      out << "\n";
+      continue;
+    }
+    out << std::setw(12) << result.expansions << std::setw(11) << std::setprecision(3)
+        << result.milliseconds << std::setw(13) << std::setprecision(0)
+        << expansionsPerSecond(result) << std::setw(10) << std::setprecision(1)
+        << nanosecondsPerExpansion(result) << std::setw(11) << result.counters.peakOpen
+        << std::setw(15) << result.searchRssKb << std::setw(11) << std::setprecision(1)
+        << result.pathCost << "\n";
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+/**
+ * Quote a string for JSON.
+ *
+ * \param text The string.
+ * \return The quoted string.
+ */
+std::string quote(const std::string& text)
+{
+  std::string quoted = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+      quoted += c;
+    } else if ((unsigned char)c < 0x20) {
+      char escape[7];
+      snprintf(escape, sizeof(escape), "\\u%04x", c);
+      quoted += escape;
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "\"";
+}
+
+/**
+ * Print the results as JSON.
+ *
+ * \param out The stream to print to.
+ * \param map The map that was searched.
+ * \param options The options of the benchmark.
+ * \param results The results of every engine.
+ */
+void printJson(std::ostream& out, const Map& map, const Options& options,
+    const std::vector<Result>& results)
+{
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << std::fixed << std::setprecision(JSON_DECIMALS);
+  out << "{\n"
+      << "  \"map\": { \"source\": " << quote(map.source)
+      << ", \"width\": " << map.width << ", \"height\": " << map.height << " },\n"
+      << "  \"warmup\": " << options.warmup << ",\n"
+      << "  \"repetitions\": " << options.repetitions << ",\n"
+      << "  \"results\": [";
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& result = results[i];
+    out << (i == 0 ? "\n" : ",\n") << "    { \"engine\": " << quote(result.engine)
+        << ", \"status\": " << quote(result.status);
+    if (result.status != "not applicable") {
+      out << ", \"expansions\": " << result.expansions
+          << ", \"median_ms\": " << result.milliseconds
+          << ", \"expansions_per_sec\": " << expansionsPerSecond(result)
+          << ", \"ns_per_expansion\": " << nanosecondsPerExpansion(result)
+          << ", \"peak_open\": " << result.counters.peakOpen
+          << ", \"search_rss_kib\": " << result.searchRssKb
+          << ", \"path_cost\": " << result.pathCost
+          << ", \"counters\": " << result.counters.json();
+    }
+    out << " }";
+  }
+  out << "\n  ]\n}\n";
+  out.flags(flags);
+  out.precision(precision);
+}
+}
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!parse(argc, argv, options)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  // Get the map.
+  Map map;
+  if (options.grid.empty()) {
+    if (!generate(options, map)) {
+      std::cerr << "The generated " << MapGenerator::describe(options.generator)
+                << " map has no two connected passable cells\n";
+      return 1;
+    }
+  } else if (!load(options.grid, map)) {
+    std::cerr << "Could not load a map with a start and goal from " << options.grid
+              << "\n";
+    return 1;
+  }
+
+  // Pick the engines.
+  std::vector<Engine> all = engineTable();
+  std::vector<Engine> chosen;
+  if (options.engines.empty()) {
+    chosen = all;
+  }
+  for (const std::string& name : options.engines) {
+    auto engine = std::find_if(all.begin(), all.end(),
+        [&](const Engine& engine) { return engine.name == name; });
+    if (engine == all.end()) {
+      std::cerr << "Unknown engine: " << name << "\n";
+      return 1;
+    }
+    chosen.push_back(*engine);
+  }
+
+  // Run them.
+  Profiler& profiler = Profiler::singleton();
+  profiler.nameThread("Benchmark");
+  profiler.setEnabled(!options.profile.empty());
+  // Measure memory first, so that every child is forked before any search has grown
+  // the benchmark's heap.
+  std::vector<long> memory;
+  for (const Engine& engine : chosen) {
+    memory.push_back(searchRssKb(map, engine));
+  }
+  std::vector<Result> results;
+  for (size_t i = 0; i < chosen.size(); i++) {
+    results.push_back(benchmark(map, chosen[i], options));
+    results.back().searchRssKb = memory[i];
+  }
+  profiler.setEnabled(false);
+  if (!options.profile.empty() && !profiler.save(options.profile)) {
+    std::cerr << "Could not write " << options.profile << "\n";
+    return 1;
+  }
+
+  // Keep stdout for the JSON when it is written there.
+  printTable(options.json == "-" ? std::cerr : std::cout, map, options, results);
+  if (options.json == "-") {
+    printJson(std::cout, map, options, results);
+  } else if (!options.json.empty()) {
+    std::ofstream out(options.json);
+    printJson(out, map, options, results);
+    if (!out) {
+      std::cerr << "Could not write " << options.json << "\n";
+      return 1;
+    }
+  }
+  return 0;
+}
\ No newline at end of file
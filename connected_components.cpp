@@ -0,0 +1,178 @@
+#include "connected_components.h"
+
+#include "grid.h"
+
+ConnectedComponents::ConnectedComponents(int size)
+    : parent_(size, 0)
+    , rank_(size, 0)
+    , detached_(size, false)
+{
+  // A new grid has no walls, so every cell points at the first one.
+  if (size > 0) {
+    rank_[0] = 1;
+  }
+}
+
+int ConnectedComponents::find(int index)
+{
+  // Find the root.
+  int root = index;
+  while (parent_[root] != root) {
+    root = parent_[root];
+  }
+
+  // Compress the path so that later finds are a single lookup.
+  while (parent_[index] != root) {
+    int next = parent_[index];
+    parent_[index] = root;
+    index = next;
+  }
+
+  return root;
+}
+
+void ConnectedComponents::unite(int a, int b)
+{
+  a = find(a);
+  b = find(b);
+  if (a == b) {
+    return;
+  }
+
+  // Union by rank keeps the trees shallow.
+  if (rank_[a] < rank_[b]) {
+    parent_[a] = b;
+  } else if (rank_[a] > rank_[b]) {
+    parent_[b] = a;
+  } else {
+    parent_[b] = a;
+    rank_[a]++;
+  }
+}
+
+void ConnectedComponents::addWall(int index, int passableNeighbors)
+{
+  // A cell that joined at most one passable neighbor cannot split its component.
+  if (passableNeighbors >= 2) {
+    invalidate();
+  }
+  detached_[index] = false;
+}
+
+bool ConnectedComponents::removeWall(int index)
+{
+  if (!detached_[index]) {
+    invalidate();
+    return false;
+  }
+
+  // Nothing points at a detached wall, so it can safely become a new component.
+  parent_[index] = index;
+  rank_[index] = 0;
+  detached_[index] = false;
+  return true;
+}
+
+void ConnectedComponents::invalidate() { valid_ = false; }
+
+bool ConnectedComponents::valid() const { return valid_; }
+
+void ConnectedComponents::rebuild(const Grid& grid)
+{
+  const int width = grid.getWidth();
+  const int height = grid.getHeight();
+  const int size = width * height;
+
+  // Walls are left as components of their own.
+  for (int i = 0; i < size; i++) {
+    parent_[i] = -1;
+    rank_[i] = 0;
+  }
+
+  /*
+   * Flood fill each unlabeled passable cell. The cell that starts the fill becomes the
+   * representative, and every cell reached is pointed straight at it.
+   */
+
+  std::vector<int> stack;
+  for (int seed = 0; seed < size; seed++) {
+    if (parent_[seed] != -1) {
+      continue;
+    }
+    parent_[seed] = seed;
+    detached_[seed] = grid.grid[seed]->cost == Grid::Cell::WALL_COST;
+    if (detached_[seed]) {
+      continue;
+    }
+    rank_[seed] = 1;
+
+    stack.push_back(seed);
+    while (!stack.empty()) {
+      const int index = stack.back();
+      stack.pop_back();
+      const int x = index % width;
+      const int y = index / width;
+
+      const int neighbors[4] = { x > 0 ? index - 1 : -1, x < width - 1 ? index + 1 : -1,
+        y > 0 ? index - width : -1, y < height - 1 ? index + width : -1 };
+      for (int neighbor : neighbors) {
+        if (neighbor == -1 || parent_[neighbor] != -1
+            || grid.grid[neighbor]->cost == Grid::Cell::WALL_COST) {
+          continue;
+        }
+        parent_[neighbor] = seed;
+        detached_[neighbor] = false;
+        stack.push_back(neighbor);
+      }
+    }
+  }
+
+  valid_ = true;
+}
+
+
+std::vector<int> ConnectedComponents::labels()
+{
+  std::vector<int> labels(parent_.size());
+  for (size_t i = 0; i < parent_.size(); i++) {
+    labels[i] = find((int)i);
+  }
+  return labels;
+}
+
+bool ConnectedComponents::assign(const Grid& grid, const int32_t* labels)
+{
+  const int size = (int)parent_.size();
+  const int width = grid.getWidth();
+  for (int i = 0; i < size; i++) {
+    const int label = labels[i];
+    const bool wall = grid.grid[i]->cost == Grid::Cell::WALL_COST;
+    bool valid = label >= 0 && label < size && labels[label] == label
+        && (wall ? label == i : grid.grid[label]->cost != Grid::Cell::WALL_COST);
+
+    // Adjacent passable cells must share a label. Checking the neighbors to the right
+    // and below covers every pair once.
+    const int neighbors[2]
+        = { i % width < width - 1 ? i + 1 : -1, i + width < size ? i + width : -1 };
+    for (int neighbor : neighbors) {
+      if (!wall && neighbor != -1 && grid.grid[neighbor]->cost != Grid::Cell::WALL_COST
+          && labels[neighbor] != label) {
+        valid = false;
+      }
+    }
+    if (!valid) {
+      invalidate();
+      return false;
+    }
+  }
+
+  // Every cell points straight at its representative, as after a rebuild.
+  for (int i = 0; i < size; i++) {
+    const bool wall = grid.grid[i]->cost == Grid::Cell::WALL_COST;
+    parent_[i] = labels[i];
+    rank_[i] = !wall && labels[i] == i ? 1 : 0;
+    detached_[i] = wall;
+  }
+  valid_ = true;
+  return true;
+}
\ No newline at end of file
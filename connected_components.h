@@ -0,0 +1,122 @@
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class Grid;
+
+/**
+ * A connected-components labeling of the passable cells in a grid.
+ *
+ * Components are kept in a union-find forest indexed by cell. Opening up a wall only
+ * ever merges components, so it is applied incrementally. Turning a cell into a wall
+ * can split a component, which union-find cannot undo; in that case the labeling is
+ * invalidated and rebuilt with a flood fill the next time it is queried.
+ *
+ * A wall that could not have split anything (it had at most one passable neighbor) is
+ * left where it is in the forest. Such a wall is no longer detached, so other cells
+ * may still be linked through it, and opening it again forces a rebuild.
+ */
+class ConnectedComponents {
+  public:
+
+  /**
+   * Construct a new Connected Components labeling.
+   * Every cell starts out in a single component.
+   *
+   * \param size The number of cells.
+   */
+  ConnectedComponents(int size);
+
+  /**
+   * Find the representative of the component containing a cell.
+   *
+   * \param index The index of the cell.
+   * \return The index of the representative cell.
+   */
+  int find(int index);
+
+  /**
+   * Merge the components containing two cells.
+   *
+   * \param a The index of the first cell.
+   * \param b The index of the second cell.
+   */
+  void unite(int a, int b);
+
+  /**
+   * Record that a passable cell has become a wall.
+   *
+   * \param index The index of the cell.
+   * \param passableNeighbors The number of passable neighbors of the cell.
+   */
+  void addWall(int index, int passableNeighbors);
+
+  /**
+   * Record that a wall has become passable.
+   * If the wall is detached from the forest it becomes a component of its own, and the
+   * caller must unite it with its passable neighbors. Otherwise the labeling is
+   * invalidated.
+   *
+   * \param index The index of the cell.
+   * \return True if the caller should unite the cell with its neighbors.
+   */
+  bool removeWall(int index);
+
+  /**
+   * Mark the labeling as out of date.
+   */
+  void invalidate();
+
+  /**
+   * Get whether the labeling is up to date.
+   *
+   * \return True if the labeling can be queried.
+   */
+  bool valid() const;
+
+  /**
+   * Relabel every cell from scratch.
+   * Each component is flood filled and every cell points directly at its
+   * representative, so that later finds take a single lookup.
+   *
+   * \param grid The grid to label.
+   */
+  void rebuild(const Grid& grid);
+
+  /**
+   * Get the representative of every cell's component.
+   * Walls are their own representatives. The labeling must be up to date.
+   *
+   * \return The representatives, indexed by cell.
+   */
+  std::vector<int> labels();
+
+  /**
+   * Replace the labeling with a saved one, such as one from `labels()`.
+   * Every label must be a passable representative, which is its own label, every wall
+   * must be its own label, and adjacent passable cells must share a label. Labels that
+   * break these rules leave the labeling out of date, so that it is rebuilt when next
+   * queried. Separate regions that share a label are not detected.
+   *
+   * \param grid The grid that was labeled.
+   * \param labels The representative of every cell's component, indexed by cell.
+   * \return True if the labels were used.
+   */
+  bool assign(const Grid& grid, const int32_t* labels);
+
+  private:
+
+  /*
+   * Data.
+   */
+
+  std::vector<int> parent_; // The parent of each cell in the union-find forest.
+  std::vector<unsigned char> rank_; // An upper bound on the height of each tree.
+  std::vector<bool> detached_; // Whether each wall is a singleton nothing points to.
+  std::atomic<bool> valid_ { true }; // Whether the labeling is up to date.
+};
+
+#endif // CONNECTED_COMPONENTS_H
\ No newline at end of file
@@ -3,9 +3,14 @@
 #include <iostream>
 
 #include "algorithms/dijkstra.h"
+#include "algorithms/path_smoother.h"
+#include "profiler.h"
 
 using SimState = GlobalState::SimState;
 
+static_assert(GlobalState::UNLIMITED_SIM_SPEED == SearchWorker::UNLIMITED_SPEED,
+    "The worker must agree with the global state on what an unlimited speed is.");
+
 GameLoop& GameLoop::singleton()
 {
   static GameLoop instance;
@@ -17,8 +22,9 @@ GameLoop::GameLoop()
   // Get a reference to the global state.
   GlobalState& globalState = GlobalState::singleton();
 
-  // Init timer.
-  timer_.setInterval(1000.0 / globalState.simSpeed());
+  // Init timer. The graphics are brought up to date once per frame, however many cells
+  // the search expanded in between.
+  timer_.setInterval(SearchWorker::FRAME_MS);
 
   // Connect the timer to the tick signal.
   connect(&timer_, &QTimer::timeout, this, &GameLoop::localTick);
@@ -27,8 +33,12 @@ GameLoop::GameLoop()
   connect(
       &globalState, &GlobalState::simStateChanged, this, &GameLoop::onSimStateChanged);
   connect(&globalState, &GlobalState::simSpeedChanged, this, &GameLoop::setLoopSpeed);
+  connect(&globalState, &GlobalState::drawChanged, this, &GameLoop::setDraw);
+  connect(&globalState, &GlobalState::profileChanged, this, &GameLoop::setProfile);
 }
 
+std::shared_ptr<SearchTrace> GameLoop::trace() const { return trace_; }
+
 /*
  * Public slots.
  */
@@ -38,12 +48,21 @@ void GameLoop::onSimStateChanged(SimState state)
   switch (state) {
   case GlobalState::SimState::RUNNING:
     timer_.start();
+    if (worker_ != nullptr) {
+      worker_->resume();
+    }
     break;
   case GlobalState::SimState::PAUSED:
     timer_.stop();
+    if (worker_ != nullptr) {
+      worker_->pause();
+    }
     break;
   case GlobalState::SimState::STOPPED:
     timer_.stop();
+    if (worker_ != nullptr) {
+      worker_->cancel();
+    }
     break;
   }
 
@@ -51,38 +70,242 @@ void GameLoop::onSimStateChanged(SimState state)
 }
 
 void GameLoop::setSim(
-    std::shared_ptr<SearchAlgorithms::SearchAlgorithm> searchAlgorithm)
+    std::shared_ptr<SearchAlgorithms::SearchAlgorithm> searchAlgorithm,
+    std::shared_ptr<Grid> grid)
 {
+  // The old search must be stopped before anything else touches its grid.
+  worker_.reset();
+
   searchAlgorithm_ = std::move(searchAlgorithm);
+  grid_ = std::move(grid);
+  events_.reset(grid_ != nullptr ? grid_->getWidth() : 0);
+  trace_ = nullptr;
+  emit traceChanged(0);
+  if (searchAlgorithm_ == nullptr) {
+    return;
+  }
+
+  // Record the search from the grid's starting state.
+  if (grid_ != nullptr) {
+    trace_ = std::make_shared<SearchTrace>(*grid_);
+  }
+
+  GlobalState& globalState = GlobalState::singleton();
+  const int width = grid_ != nullptr ? grid_->getWidth() : 0;
+  worker_.reset(new SearchWorker(searchAlgorithm_, width, trace_));
+  worker_->setPace(globalState.draw(), globalState.simSpeed());
+  if (globalState.simState() == SimState::RUNNING) {
+    worker_->resume();
+  }
 }
 
 void GameLoop::setLoopSpeed(int speed)
 {
-  timer_.setInterval(1000.0 / speed);
+  if (worker_ != nullptr) {
+    worker_->setPace(GlobalState::singleton().draw(), speed);
+  }
   std::cout << "Game loop updated." << std::endl;
 }
 
+void GameLoop::setDraw(bool draw)
+{
+  if (worker_ == nullptr) {
+    return;
+  }
+  worker_->setPace(draw, GlobalState::singleton().simSpeed());
+
+  // Catch the graphics up with everything that was searched while nothing was drawn.
+  if (draw) {
+    std::lock_guard<std::mutex> lock(worker_->gridMutex());
+    events_.clear();
+    worker_->poll(events_);
+    recordSearchedCells();
+    if (trace_ != nullptr) {
+      trace_->sync(*grid_);
+    }
+    emit updateGraphics(events_);
+  }
+
+  std::cout << "Game loop updated." << std::endl;
+}
+
+void GameLoop::setProfile(bool profile) { Profiler::singleton().setEnabled(profile); }
+
+void GameLoop::setTrace(std::shared_ptr<SearchTrace> trace, std::shared_ptr<Grid> grid)
+{
+  setSim(nullptr, std::move(grid));
+  trace_ = std::move(trace);
+  if (trace_ != nullptr) {
+    emit traceChanged((int)trace_->steps());
+  }
+}
+
+void GameLoop::seekTrace(int step)
+{
+  // The grid belongs to the search until it has finished.
+  if (worker_ != nullptr || trace_ == nullptr || grid_ == nullptr) {
+    return;
+  }
+
+  // Only the cells whose state differs from the step need to be redrawn.
+  trace_->seek(step, traceStates_);
+  events_.clear();
+  for (size_t i = 0; i < traceStates_.size(); i++) {
+    Grid::Cell& cell = *grid_->grid[i];
+    if (cell.vis != traceStates_[i]) {
+      cell.vis = traceStates_[i];
+      events_.push(cell);
+    }
+  }
+  emit updateGraphics(events_);
+}
+
 /*
  * Private slots.
  */
 
 void GameLoop::localTick()
 {
-  if (searchAlgorithm_ == nullptr) {
+  PROFILE_SCOPE("GameLoop::localTick");
+  if (worker_ == nullptr) {
+    return;
+  }
+
+  using Status = SearchAlgorithms::SearchAlgorithm::Status;
+
+  // Read the status first: once the search has finished, all of its events are queued.
+  const Status status = worker_->status();
+
+  // Draw whatever the worker has done since the last tick.
+  events_.clear();
+  worker_->poll(events_);
+  emit tick();
+  if (!events_.empty()) {
+    std::lock_guard<std::mutex> lock(worker_->gridMutex());
+    emit updateGraphics(events_);
+  }
+  if (!GlobalState::singleton().draw()) {
+    emit headlessProgress(worker_->expansions(),
+        grid_ != nullptr ? grid_->getWidth() * grid_->getHeight() : 0);
+  }
+  emit countersChanged(worker_->counters());
+
+  if (status != Status::RUNNING) {
+    finish(status);
+  }
+}
+
+/*
+ * Private.
+ */
+
+void GameLoop::finish(SearchAlgorithms::SearchAlgorithm::Status status)
+{
+  using Status = SearchAlgorithms::SearchAlgorithm::Status;
+  GlobalState& globalState = GlobalState::singleton();
+  const bool draw = globalState.draw();
+
+  // The worker is done with the search, so the grid can be used freely.
+  timer_.stop();
+  globalState.setSimState(GlobalState::SimState::PAUSED);
+  events_.clear();
+  if (!draw) {
+    recordSearchedCells();
+  }
+
+  if (status == Status::FOUND) {
+    if (globalState.smoothPaths() && grid_ != nullptr) {
+      smoothPath(searchAlgorithm_->path());
+    } else {
+      for (const auto& cell : searchAlgorithm_->path()) {
+        events_.push(*cell);
+      }
+    }
+  } else {
+    std::cout << "No path found." << std::endl;
+  }
+  emit updateGraphics(events_);
+
+  // Catch the trace up with the path, and anything searched while nothing was drawn.
+  if (trace_ != nullptr) {
+    trace_->sync(*grid_);
+  }
+
+  // Report how fast the search ran while nothing was drawn.
+  const unsigned long expansions = worker_->headlessExpansions();
+  const double milliseconds = worker_->headlessMilliseconds();
+  if (!draw) {
+    std::cout << "Searched without drawing: " << expansions << " expansions in "
+              << milliseconds << " ms";
+    if (milliseconds > 0) {
+      std::cout << " (" << expansions * 1000.0 / milliseconds << " expansions/sec)";
+    }
+    std::cout << std::endl;
+    emit headlessFinished(expansions, milliseconds);
+  }
+
+  // Report what the search did, now that it can no longer change.
+  emit countersChanged(searchAlgorithm_->counters());
+
+  // The search can't be resumed once it has finished.
+  worker_.reset();
+
+  // The finished search can now be scrubbed through.
+  if (trace_ != nullptr) {
+    emit traceChanged((int)trace_->steps());
+  }
+}
+
+void GameLoop::recordSearchedCells()
+{
+  using Cell = Grid::Cell;
+
+  if (grid_ == nullptr) {
     return;
   }
-  try {
-    auto cells = searchAlgorithm_->step();
-    emit tick();
-    emit updateGraphics(cells);
-    if (cells.empty()) {
-      timer_.stop();
-      GlobalState::singleton().setSimState(GlobalState::SimState::PAUSED);
-      emit updateGraphics(searchAlgorithm_->path());
+  const int size = grid_->getWidth() * grid_->getHeight();
+  for (int i = 0; i < size; i++) {
+    const Cell& cell = *grid_->grid[i];
+    switch (cell.vis) {
+    case Cell::VisualizationState::OPEN_LIST:
+    case Cell::VisualizationState::CLOSED_LIST:
+    case Cell::VisualizationState::PATH:
+      events_.push(cell);
+    default:
+      break;
     }
-  } catch (SearchAlgorithms::NoPathFoundException& e) {
-    std::cout << e.what() << std::endl;
-    timer_.stop();
-    GlobalState::singleton().setSimState(GlobalState::SimState::PAUSED);
+  }
+}
+
+void GameLoop::smoothPath(const std::vector<std::shared_ptr<Grid::Cell>>& path)
+{
+  using Cell = Grid::Cell;
+
+  SearchAlgorithms::PathSmoother smoother(grid_);
+  SearchAlgorithms::PathSmoother::Result result = smoother.smooth(path);
+
+  std::cout << "Smoothed path: length " << result.lengthBefore << " -> "
+            << result.lengthAfter << ", cost " << result.costBefore << " -> "
+            << result.costAfter << " in " << result.milliseconds << " ms" << std::endl;
+
+  // Take the old path off the grid.
+  for (auto cell : path) {
+    cell->link = nullptr;
+    if (cell->vis == Cell::VisualizationState::PATH) {
+      cell->vis = Cell::VisualizationState::CLOSED_LIST;
+    }
+    events_.push(*cell);
+  }
+
+  // Show the new path, with each corner linked to the one before it.
+  for (auto cell : result.path) {
+    if (cell->vis != Cell::VisualizationState::START
+        && cell->vis != Cell::VisualizationState::GOAL) {
+      cell->vis = Cell::VisualizationState::PATH;
+    }
+    events_.push(*cell);
+  }
+  for (size_t i = 1; i < result.waypoints.size(); i++) {
+    result.waypoints[i]->link = result.waypoints[i - 1].get();
   }
 }
\ No newline at end of file
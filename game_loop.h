@@ -7,6 +7,7 @@
 
 #include "algorithms/search_algorithm.h"
 #include "global_state.h"
+#include "search_worker.h"
 
 class GameLoop : public QObject {
   Q_OBJECT
@@ -35,29 +36,78 @@ class GameLoop : public QObject {
    */
   void operator=(GameLoop const&) = delete;
 
+  /**
+   * Get the trace of the current search.
+   * The trace is only complete once the search has finished.
+   *
+   * \return The trace, or nullptr if there is no search.
+   */
+  std::shared_ptr<SearchTrace> trace() const;
+
   public slots:
 
   /**
-   * Start or resume the game loop.
+   * Start, pause or stop the search.
    */
   void onSimStateChanged(GlobalState::SimState state);
 
   /**
    * Change the sim type.
+   * Any search that is already running is cancelled first, and the new one is run on a
+   * worker thread.
+   *
+   * \param searchAlgorithm The search algorithm to step through.
+   * \param grid The grid being searched, which is needed to smooth the path.
    */
-  void setSim(std::shared_ptr<SearchAlgorithms::SearchAlgorithm> searchAlgorithm);
+  void setSim(std::shared_ptr<SearchAlgorithms::SearchAlgorithm> searchAlgorithm,
+      std::shared_ptr<Grid> grid = nullptr);
 
   /**
-   * Change the speed of the game loop.
+   * Change the speed of the search.
    *
-   * \param speed The speed of the game loop (ticks/second).
+   * \param speed The speed of the search (expansions/second), or unlimited.
    */
   void setLoopSpeed(int speed);
 
+  /**
+   * Switch between drawing every step and searching at full speed.
+   * When drawing is turned back on, every cell searched so far is drawn.
+   *
+   * \param draw Whether or not to draw the simulation.
+   */
+  void setDraw(bool draw);
+
+  /**
+   * Start or stop recording timings for the profiler.
+   * Starting again discards the timings recorded before.
+   *
+   * \param profile Whether or not to record timings.
+   */
+  void setProfile(bool profile);
+
+  /**
+   * Show a recorded trace in place of a search.
+   * Any search that is running is cancelled first. The trace can then be scrubbed
+   * through with `seekTrace()`.
+   *
+   * \param trace The trace to show.
+   * \param grid The grid to show it on, which must be the size of the traced grid.
+   */
+  void setTrace(std::shared_ptr<SearchTrace> trace, std::shared_ptr<Grid> grid);
+
+  /**
+   * Show the state of the grid after a step of the trace.
+   * This does nothing while the search is still running.
+   *
+   * \param step The number of steps of the trace to show.
+   */
+  void seekTrace(int step);
+
   private slots:
 
   /**
    * The game loop tick.
+   * Cell events from the worker are drawn, and a finished search is wrapped up.
    */
   void localTick();
 
@@ -70,17 +120,82 @@ class GameLoop : public QObject {
 
   /**
    * Emit a signal that the graphics need to be updated.
+   * The events are only valid until the next tick.
+   *
+   * \param events The cells that changed.
+   */
+  void updateGraphics(const SearchAlgorithms::CellEventBuffer& events);
+
+  /**
+   * Emit a signal with the progress of a search that is not being drawn.
+   *
+   * \param expansions The number of expansions done so far.
+   * \param cells The number of cells in the grid.
+   */
+  void headlessProgress(unsigned long expansions, int cells);
+
+  /**
+   * Emit a signal that a search that was not being drawn has finished.
+   *
+   * \param expansions The number of expansions done without drawing.
+   * \param milliseconds The wall-clock time taken by those expansions.
+   */
+  void headlessFinished(unsigned long expansions, double milliseconds);
+
+  /**
+   * Emit a signal with the counts of what the current search has done.
+   * This is emitted every tick while the search runs, and once more when it finishes.
+   *
+   * \param counters The counts.
+   */
+  void countersChanged(const SearchAlgorithms::SearchCounters& counters);
+
+  /**
+   * Emit a signal that the trace that can be scrubbed through has changed.
+   *
+   * \param steps The number of steps in the trace, or 0 if there is nothing to scrub.
    */
-  void updateGraphics(std::vector<std::shared_ptr<Grid::Cell>> cells);
+  void traceChanged(int steps);
 
   private:
 
+  /**
+   * Wrap up a finished search, drawing the path and reporting statistics.
+   *
+   * \param status How the search finished.
+   */
+  void finish(SearchAlgorithms::SearchAlgorithm::Status status);
+
+  /**
+   * Add every cell that the search has touched to the event buffer.
+   * Cells are not recorded while the search isn't being drawn, so this brings the
+   * graphics area up to date in one batch.
+   */
+  void recordSearchedCells();
+
+  /**
+   * Smooth a found path and update the visualization to match.
+   * Cells that drop out of the path are shown as closed, and the corners of the new
+   * path are linked so that it is drawn as straight segments.
+   *
+   * Every cell whose graphics need to be updated is added to the event buffer.
+   *
+   * \param path The path found by the search algorithm.
+   */
+  void smoothPath(const std::vector<std::shared_ptr<Grid::Cell>>& path);
+
   /*
    * Data.
    */
 
   std::shared_ptr<SearchAlgorithms::SearchAlgorithm> searchAlgorithm_
       = nullptr; // The search algorithm to use.
+  std::shared_ptr<Grid> grid_ = nullptr; // The grid being searched.
+  std::unique_ptr<SearchWorker> worker_; // The thread running the search.
+  SearchAlgorithms::CellEventBuffer events_; // The cells changed since the last tick.
+  std::shared_ptr<SearchTrace> trace_ = nullptr; // The trace of the current search.
+  std::vector<Grid::Cell::VisualizationState>
+      traceStates_; // The cell states at the step being sought.
 
   QTimer timer_; // The timer that drives the game loop.
 };
@@ -22,6 +22,10 @@ int GlobalState::simSpeed() const { return simSpeed_; }
 
 bool GlobalState::draw() const { return draw_; }
 
+bool GlobalState::smoothPaths() const { return smoothPaths_; }
+
+bool GlobalState::profile() const { return profile_; }
+
 /*
  * Setters.
  */
@@ -59,6 +63,21 @@ void GlobalState::setSimType(SimType type)
   case SimType::ASTAR:
     std::cout << "Sim type changed to ASTAR" << std::endl;
     break;
+  case SimType::HDA_STAR:
+    std::cout << "Sim type changed to HDA_STAR" << std::endl;
+    break;
+  case SimType::SUBGOAL:
+    std::cout << "Sim type changed to SUBGOAL" << std::endl;
+    break;
+  case SimType::FRINGE:
+    std::cout << "Sim type changed to FRINGE" << std::endl;
+    break;
+  case SimType::THETA_STAR:
+    std::cout << "Sim type changed to THETA_STAR" << std::endl;
+    break;
+  case SimType::LAZY_THETA_STAR:
+    std::cout << "Sim type changed to LAZY_THETA_STAR" << std::endl;
+    break;
   }
 }
 
@@ -66,7 +85,11 @@ void GlobalState::setSimSpeed(int speed)
 {
   simSpeed_ = speed;
   emit simSpeedChanged(speed);
-  std::cout << "Sim speed changed to " << speed << std::endl;
+  if (speed == UNLIMITED_SIM_SPEED) {
+    std::cout << "Sim speed changed to unlimited" << std::endl;
+  } else {
+    std::cout << "Sim speed changed to " << speed << std::endl;
+  }
 }
 
 void GlobalState::setDraw(bool draw)
@@ -74,4 +97,18 @@ void GlobalState::setDraw(bool draw)
   draw_ = draw;
   emit drawChanged(draw);
   std::cout << "Draw changed to " << draw << std::endl;
+}
+
+void GlobalState::setSmoothPaths(bool smooth)
+{
+  smoothPaths_ = smooth;
+  emit smoothPathsChanged(smooth);
+  std::cout << "Smooth paths changed to " << smooth << std::endl;
+}
+
+void GlobalState::setProfile(bool profile)
+{
+  profile_ = profile;
+  emit profileChanged(profile);
+  std::cout << "Profile changed to " << profile << std::endl;
 }
\ No newline at end of file
@@ -23,7 +23,12 @@ class GlobalState : public QObject {
   enum class SimType {
     NONE, // No simulation type.
     DIJKSTRA, // Dijkstra's algorithm.
-    ASTAR // A* algorithm.
+    ASTAR, // A* algorithm.
+    HDA_STAR, // Hash-distributed parallel A* algorithm.
+    SUBGOAL, // A* over a subgoal graph.
+    FRINGE, // Fringe Search.
+    THETA_STAR, // Theta* any-angle search.
+    LAZY_THETA_STAR // Lazy Theta* any-angle search.
   };
 
   static constexpr int MIN_CELL_COST = 1; // The minimum cost of a cell.
@@ -32,6 +37,10 @@ class GlobalState : public QObject {
   static constexpr int GRID_HEIGHT = 10; // The height of the grid.
   static constexpr float CELL_BORDER_WIDTH
       = 1.5; // The width of the border around a cell.
+  static constexpr int MAX_SIM_SPEED
+      = 1000000; // The fastest limited simulation speed (expansions/second).
+  static constexpr int UNLIMITED_SIM_SPEED
+      = 0; // A simulation speed that doesn't limit the expansion rate.
 
   signals:
 
@@ -52,7 +61,7 @@ class GlobalState : public QObject {
   /**
    * Emit a signal to update the simulation speed.
    *
-   * \param speed The simulation speed.
+   * \param speed The simulation speed (expansions/second), or UNLIMITED_SIM_SPEED.
    */
   void simSpeedChanged(int speed);
 
@@ -63,6 +72,20 @@ class GlobalState : public QObject {
    */
   void drawChanged(bool draw);
 
+  /**
+   * Emit a signal to update whether or not to smooth found paths.
+   *
+   * \param smooth Whether or not to smooth found paths.
+   */
+  void smoothPathsChanged(bool smooth);
+
+  /**
+   * Emit a signal to update whether or not to record timings for the profiler.
+   *
+   * \param profile Whether or not to record timings.
+   */
+  void profileChanged(bool profile);
+
   public:
 
   /**
@@ -108,7 +131,7 @@ class GlobalState : public QObject {
   /**
    * Get the simulation speed.
    *
-   * \return The simulation speed.
+   * \return The simulation speed (expansions/second), or UNLIMITED_SIM_SPEED.
    */
   int simSpeed() const;
 
@@ -119,6 +142,20 @@ class GlobalState : public QObject {
    */
   bool draw() const;
 
+  /**
+   * Get whether or not to smooth found paths.
+   *
+   * \return Whether or not to smooth found paths.
+   */
+  bool smoothPaths() const;
+
+  /**
+   * Get whether or not to record timings for the profiler.
+   *
+   * \return Whether or not to record timings.
+   */
+  bool profile() const;
+
   /*
    * Setters.
    */
@@ -140,7 +177,7 @@ class GlobalState : public QObject {
   /**
    * Set the simulation speed.
    *
-   * \param speed The simulation speed.
+   * \param speed The simulation speed (expansions/second), or UNLIMITED_SIM_SPEED.
    */
   void setSimSpeed(int speed);
 
@@ -151,6 +188,20 @@ class GlobalState : public QObject {
    */
   void setDraw(bool draw);
 
+  /**
+   * Set whether or not to smooth found paths.
+   *
+   * \param smooth Whether or not to smooth found paths.
+   */
+  void setSmoothPaths(bool smooth);
+
+  /**
+   * Set whether or not to record timings for the profiler.
+   *
+   * \param profile Whether or not to record timings.
+   */
+  void setProfile(bool profile);
+
   private:
 
   /*
@@ -159,8 +210,10 @@ class GlobalState : public QObject {
 
   SimState simState_ = SimState::STOPPED; // The simulation state.
   SimType simType_ = SimType::NONE; // The simulation type.
-  int simSpeed_ = 1; // The simulation speed.
+  int simSpeed_ = 1; // The simulation speed (expansions/second).
   bool draw_ = true; // Whether or not to draw the simulation.
+  bool smoothPaths_ = false; // Whether or not to smooth found paths.
+  bool profile_ = false; // Whether or not to record timings for the profiler.
 };
 
 #endif // APPLICATION_STATE_H
\ No newline at end of file
@@ -6,33 +6,21 @@
 Grid::Grid(int width, int height)
     : width(width)
     , height(height)
+    , components_(width * height)
 {
-  // Allocate the grid.
-  grid = new std::shared_ptr<Cell>[width * height];
-
-  // Create initial name.
-  constexpr int charCount = 26;
-  int nameNum = 1;
+  // Allocate the grid. The cells are allocated in one block, which every cell pointer
+  // shares ownership of, rather than one at a time.
+  const int cellCount = width * height;
+  cells_ = std::shared_ptr<Cell>(new Cell[cellCount], std::default_delete<Cell[]>());
+  grid = new std::shared_ptr<Cell>[cellCount];
 
   // Initialize the grid.
   for (int y = 0; y < height; y++) {
     for (int x = 0; x < width; x++) {
-      grid[y * width + x] = std::make_shared<Cell>();
-      grid[y * width + x]->x = x;
-      grid[y * width + x]->y = y;
-
-      // Generate name.
-      int tmp = nameNum;
-      grid[y * width + x]->name = "";
-      while (tmp > 0) {
-        grid[y * width + x]->name += 'A' + (tmp - 1) % charCount;
-        tmp = (tmp - 1) / charCount;
-      }
-
-      // Reverse name.
-      reverse(grid[y * width + x]->name.begin(), grid[y * width + x]->name.end());
-
-      ++nameNum;
+      Cell& cell = cells_.get()[y * width + x];
+      grid[y * width + x] = std::shared_ptr<Cell>(cells_, &cell);
+      cell.x = x;
+      cell.y = y;
     }
   }
 }
@@ -43,6 +31,18 @@ Grid::~Grid()
   delete[] grid;
 }
 
+std::string Grid::cellName(int index)
+{
+  // Names count up in base 26, like spreadsheet columns.
+  constexpr int charCount = 26;
+  std::string name;
+  for (int tmp = index + 1; tmp > 0; tmp = (tmp - 1) / charCount) {
+    name += 'A' + (tmp - 1) % charCount;
+  }
+  reverse(name.begin(), name.end());
+  return name;
+}
+
 int Grid::getWidth() const { return width; }
 
 int Grid::getHeight() const { return height; }
@@ -83,4 +83,98 @@ std::vector<std::shared_ptr<Grid::Cell>> Grid::getNeighbors(
   }
 
   return neighbors;
+}
+
+void Grid::setCost(std::shared_ptr<Cell> cell, unsigned int cost)
+{
+  const unsigned int oldCost = cell->cost;
+  cell->cost = cost;
+
+  // Changing between two passable costs does not affect connectivity.
+  const bool wasWall = oldCost == Cell::WALL_COST;
+  const bool isWall = cost == Cell::WALL_COST;
+  if (wasWall == isWall || !components_.valid()) {
+    return;
+  }
+
+  const int index = cell->y * width + cell->x;
+  std::vector<std::shared_ptr<Cell>> neighbors = getNeighbors(cell);
+
+  // Opening a wall merges the cell with all of its passable neighbors.
+  if (wasWall) {
+    if (components_.removeWall(index)) {
+      for (auto neighbor : neighbors) {
+        if (neighbor->cost != Cell::WALL_COST) {
+          components_.unite(index, neighbor->y * width + neighbor->x);
+        }
+      }
+    }
+    return;
+  }
+
+  // Adding a wall may split a component, which is only detected by relabeling.
+  int passableNeighbors = 0;
+  for (auto neighbor : neighbors) {
+    if (neighbor->cost != Cell::WALL_COST) {
+      passableNeighbors++;
+    }
+  }
+  components_.addWall(index, passableNeighbors);
+}
+
+void Grid::setRowCosts(int y, const std::vector<unsigned int>& costs)
+{
+  if (y < 0 || y >= height || (int)costs.size() != width) {
+    throw std::out_of_range("Row out of range.");
+  }
+  for (int x = 0; x < width; x++) {
+    grid[y * width + x]->cost = costs[x];
+  }
+  components_.invalidate();
+}
+
+bool Grid::connected(std::shared_ptr<Cell> a, std::shared_ptr<Cell> b)
+{
+  if (a->cost == Cell::WALL_COST || b->cost == Cell::WALL_COST) {
+    return false;
+  }
+  if (!components_.valid()) {
+    components_.rebuild(*this);
+  }
+  return components_.find(a->y * width + a->x) == components_.find(b->y * width + b->x);
+}
+
+std::vector<int> Grid::componentLabels()
+{
+  if (!components_.valid()) {
+    components_.rebuild(*this);
+  }
+  return components_.labels();
+}
+
+bool Grid::setComponentLabels(const int32_t* labels)
+{
+  return components_.assign(*this, labels);
+}
+
+bool Grid::largestRegionEnds(int& start, int& goal)
+{
+  const int cells = width * height;
+  const std::vector<int> labels = componentLabels();
+  std::vector<int> sizes(cells, 0);
+  int largest = -1;
+  for (int i = 0; i < cells; i++) {
+    if (grid[i]->cost != Cell::WALL_COST && ++sizes[labels[i]] >= 2
+        && (largest == -1 || sizes[labels[i]] > sizes[largest])) {
+      largest = labels[i];
+    }
+  }
+  start = goal = -1;
+  for (int i = 0; largest != -1 && i < cells; i++) {
+    if (labels[i] == largest && grid[i]->cost != Cell::WALL_COST) {
+      goal = i;
+      start = start == -1 ? i : start;
+    }
+  }
+  return largest != -1;
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <vector>
 #include <string>
 
+#include "connected_components.h"
+
 /**
  * A grid of cells.
  */
@@ -35,12 +37,12 @@ class Grid {
 
     int x = 0; // The x coordinate of the cell.
     int y = 0; // The y coordinate of the cell.
-    unsigned int cost = 1; // The cost of traversing the cell.
+    unsigned int cost = 1; // The cost of traversing the cell (see Grid::setCost).
     bool selected = false; // Whether the cell is selected.
     void* searchData = nullptr; // The search data associated with the cell.
+    Cell* link = nullptr; // A cell joined to this one by a drawn segment, if any.
     VisualizationState vis
         = VisualizationState::UNVISITED; // The visualization state of the cell.
-    std::string name = ""; // The name of the cell.
     std::string text_tr = ""; // The text in the top right of the cell.
     std::string text_bl = ""; // The text in the bottom left of the cell.
     std::string text_br = ""; // The text in the bottom right of the cell.
@@ -59,6 +61,14 @@ class Grid {
    */
   ~Grid();
 
+  /**
+   * Get the name of a cell, which is shown in its corner.
+   *
+   * \param index The index of the cell, `y * width + x`.
+   * \return The name of the cell: A to Z, then AA, AB and so on.
+   */
+  static std::string cellName(int index);
+
   /**
    * Get the width of the grid.
    *
@@ -91,6 +101,65 @@ class Grid {
    */
   std::vector<std::shared_ptr<Cell>> getNeighbors(std::shared_ptr<Cell> cell) const;
 
+  /**
+   * Set the cost of a cell.
+   * Costs should always be changed through this function, so that the connected
+   * components of the grid are kept up to date.
+   *
+   * \param cell The cell to update.
+   * \param cost The new cost of the cell.
+   */
+  void setCost(std::shared_ptr<Cell> cell, unsigned int cost);
+
+  /**
+   * Set the costs of a whole row of cells.
+   * This is for filling in a new grid: rather than being kept up to date cell by cell,
+   * the connected components are relabeled the next time they are queried. Different
+   * rows can be set from several threads at once.
+   *
+   * \param y The y coordinate of the row.
+   * \param costs The costs of the cells in the row, from left to right.
+   */
+  void setRowCosts(int y, const std::vector<unsigned int>& costs);
+
+  /**
+   * Check whether a path can exist between two cells.
+   * This is a constant-time lookup, unless walls have been added since the last query,
+   * in which case the components are relabeled first.
+   *
+   * \param a The first cell.
+   * \param b The second cell.
+   * \return True if both cells are passable and in the same connected component.
+   */
+  bool connected(std::shared_ptr<Cell> a, std::shared_ptr<Cell> b);
+
+  /**
+   * Get the connected components of the grid, relabeling them first if needed.
+   *
+   * \return The representative of every cell's component, indexed `y * width + x`.
+   *         Walls are their own representatives.
+   */
+  std::vector<int> componentLabels();
+
+  /**
+   * Use saved connected components rather than relabeling the grid.
+   *
+   * \param labels The representative of every cell's component, as returned by
+   *               `componentLabels()` for a grid with the same walls.
+   * \return True if the labels were used, or false if they were not consistent.
+   */
+  bool setComponentLabels(const int32_t* labels);
+
+  /**
+   * Find the first and last cells of the largest connected region, between which a
+   * path always exists.
+   *
+   * \param start Set to the index of the first cell, or -1 if there is none.
+   * \param goal Set to the index of the last cell, or -1 if there is none.
+   * \return False if no two passable cells are connected.
+   */
+  bool largestRegionEnds(int& start, int& goal);
+
   /*
    * Data.
    */
@@ -105,6 +174,14 @@ class Grid {
 
   int width; // The width of the grid.
   int height; // The height of the grid.
+
+  /*
+   * Data.
+   */
+
+  std::shared_ptr<Cell> cells_; // The block that all of the cells are allocated in.
+
+  ConnectedComponents components_; // The connected components of passable cells.
 };
 
 #endif // GRID_H
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include "grid_snapshot.h"
+
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr uint32_t GridSnapshot::VERSION;
+constexpr unsigned int GridSnapshot::MAX_COST;
+constexpr uint32_t GridSnapshot::BYTE_ORDER_MARK;
+constexpr uint32_t GridSnapshot::HAS_COMPONENTS;
+
+namespace {
+
+const char MAGIC[8] = { 'S', 'V', 'G', 'R', 'I', 'D', '\r', '\n' }; // The magic number.
+constexpr uint8_t WALL_BYTE = 0; // The saved cost of a wall.
+
+/**
+ * Round an offset up to the next multiple of eight.
+ *
+ * \param offset The offset.
+ * \return The aligned offset.
+ */
+uint64_t align(uint64_t offset) { return (offset + 7) & ~(uint64_t)7; }
+}
+
+GridSnapshot::GridSnapshot() { }
+
+GridSnapshot::~GridSnapshot() { close(); }
+
+bool GridSnapshot::save(
+    const std::string& path, Grid& grid, int start, int goal, bool components)
+{
+  const int cells = grid.getWidth() * grid.getHeight();
+  if (start < -1 || start >= cells || goal < -1 || goal >= cells) {
+    return false;
+  }
+
+  // Pack the costs first, so that a cost that doesn't fit leaves no file behind.
+  std::vector<uint8_t> costs(cells);
+  for (int i = 0; i < cells; i++) {
+    const unsigned int cost = grid.grid[i]->cost;
+    if (cost == Grid::Cell::WALL_COST) {
+      costs[i] = WALL_BYTE;
+    } else if (cost == WALL_BYTE || cost > MAX_COST) {
+      return false;
+    } else {
+      costs[i] = (uint8_t)cost;
+    }
+  }
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.flags = components ? HAS_COMPONENTS : 0;
+  header.width = grid.getWidth();
+  header.height = grid.getHeight();
+  header.start = start;
+  header.goal = goal;
+  header.costsOffset = sizeof(Header);
+  header.componentsOffset = components ? align(header.costsOffset + cells) : 0;
+
+  std::ofstream out(path, std::ios::binary);
+  out.write((const char*)&header, sizeof(header));
+  out.write((const char*)costs.data(), costs.size());
+  if (components) {
+    const std::vector<int> labels = grid.componentLabels();
+    const std::vector<int32_t> table(labels.begin(), labels.end());
+    const std::vector<char> padding(
+        header.componentsOffset - header.costsOffset - cells);
+    out.write(padding.data(), padding.size());
+    out.write((const char*)table.data(), table.size() * sizeof(int32_t));
+  }
+  return (bool)out;
+}
+
+bool GridSnapshot::open(const std::string& path)
+{
+  close();
+
+#ifndef _WIN32
+  const int file = ::open(path.c_str(), O_RDONLY);
+  if (file == -1) {
+    return false;
+  }
+  struct stat status;
+  if (fstat(file, &status) == 0 && status.st_size >= (off_t)sizeof(Header)) {
+    void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data != MAP_FAILED) {
+      data_ = (const char*)data;
+      size_ = status.st_size;
+      mapped_ = true;
+    }
+  }
+  ::close(file);
+#else
+  std::ifstream in(path, std::ios::binary);
+  buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+
+  // Check the header, and that every table fits in the file.
+  if (size_ < sizeof(Header)) {
+    close();
+    return false;
+  }
+  std::memcpy(&header_, data_, sizeof(Header));
+  const uint64_t cells = (uint64_t)header_.width * (uint64_t)header_.height;
+  const bool components = (header_.flags & HAS_COMPONENTS) != 0;
+  const bool valid = std::memcmp(header_.magic, MAGIC, sizeof(MAGIC)) == 0
+      && header_.version == VERSION && header_.byteOrder == BYTE_ORDER_MARK
+      && header_.width > 0 && header_.height > 0 && cells <= INT32_MAX
+      && header_.start >= -1 && header_.start < (int64_t)cells && header_.goal >= -1
+      && header_.goal < (int64_t)cells && header_.costsOffset >= sizeof(Header)
+      && header_.costsOffset <= size_ && cells <= size_ - header_.costsOffset
+      && (!components
+          || (header_.componentsOffset % sizeof(int32_t) == 0
+              && header_.componentsOffset <= size_
+              && cells <= (size_ - header_.componentsOffset) / sizeof(int32_t)));
+  if (!valid) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<Grid> GridSnapshot::grid() const
+{
+  if (data_ == nullptr) {
+    return nullptr;
+  }
+
+  const int width = header_.width;
+  std::shared_ptr<Grid> grid = std::make_shared<Grid>(width, header_.height);
+  const uint8_t* costs = this->costs();
+  std::vector<unsigned int> row(width);
+  for (int y = 0; y < header_.height; y++) {
+    for (int x = 0; x < width; x++) {
+      const uint8_t cost = costs[y * width + x];
+      row[x] = cost == WALL_BYTE ? Grid::Cell::WALL_COST : cost;
+    }
+    grid->setRowCosts(y, row);
+  }
+  if (components() != nullptr) {
+    grid->setComponentLabels(components());
+  }
+  return grid;
+}
+
+int GridSnapshot::width() const { return data_ != nullptr ? header_.width : 0; }
+
+int GridSnapshot::height() const { return data_ != nullptr ? header_.height : 0; }
+
+int GridSnapshot::start() const { return data_ != nullptr ? header_.start : -1; }
+
+int GridSnapshot::goal() const { return data_ != nullptr ? header_.goal : -1; }
+
+const uint8_t* GridSnapshot::costs() const
+{
+  return data_ != nullptr ? (const uint8_t*)(data_ + header_.costsOffset) : nullptr;
+}
+
+const int32_t* GridSnapshot::components() const
+{
+  if (data_ == nullptr || (header_.flags & HAS_COMPONENTS) == 0) {
+    return nullptr;
+  }
+  return (const int32_t*)(data_ + header_.componentsOffset);
+}
+
+bool GridSnapshot::isSnapshotPath(const std::string& path)
+{
+  const std::string extension = ".grid";
+  return path.size() >= extension.size()
+      && path.compare(path.size() - extension.size(), extension.size(), extension)
+      == 0;
+}
+
+/*
+ * Private.
+ */
+
+void GridSnapshot::close()
+{
+#ifndef _WIN32
+  if (mapped_) {
+    munmap((void*)data_, size_);
+  }
+#endif
+  buffer_.clear();
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#ifndef GRID_SNAPSHOT_H
+#define GRID_SNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "grid.h"
+
+/**
+ * A grid saved in a compact binary file, which is memory-mapped to load it.
+ *
+ * The file is a fixed-size header followed by the cell costs, one byte per cell in the
+ * order `y * width + x`, with 0 standing for a wall. The header holds a magic number,
+ * the format version, the byte order it was written in, the grid's size, its start and
+ * goal cells, and the offset of each table. The grid's connected components can be
+ * saved as an optional table too, so that loading doesn't have to relabel them.
+ *
+ * Opening a snapshot only maps the file and checks the header, so the cost table is
+ * read in place rather than parsed. A file written by a newer version of the format,
+ * or on a machine with a different byte order, is refused.
+ */
+class GridSnapshot {
+  public:
+
+  static constexpr uint32_t VERSION = 1; // The version of the format that is written.
+  static constexpr unsigned int MAX_COST = 255; // The highest cost that can be saved.
+
+  /**
+   * Construct a new Grid Snapshot with nothing open.
+   */
+  GridSnapshot();
+
+  /**
+   * Close the snapshot.
+   */
+  ~GridSnapshot();
+
+  /**
+   * Don't allow the Grid Snapshot to be copied.
+   */
+  GridSnapshot(GridSnapshot const&) = delete;
+
+  /**
+   * Don't allow the Grid Snapshot to be assigned.
+   */
+  void operator=(GridSnapshot const&) = delete;
+
+  /**
+   * Save a grid to a file.
+   *
+   * \param path The path of the file.
+   * \param grid The grid, whose components are relabeled if they are out of date.
+   * \param start The index of the start cell, or -1 if there is none.
+   * \param goal The index of the goal cell, or -1 if there is none.
+   * \param components Whether to save the connected components as well.
+   * \return False if the file can't be written or a cost is above MAX_COST.
+   */
+  static bool save(const std::string& path, Grid& grid, int start, int goal,
+      bool components = true);
+
+  /**
+   * Open a snapshot, closing any that is already open.
+   *
+   * \param path The path of the file.
+   * \return False if the file can't be read or is not a valid snapshot.
+   */
+  bool open(const std::string& path);
+
+  /**
+   * Build a grid from the open snapshot.
+   * The costs are copied into the grid's cells, so this takes time in proportion to
+   * the size of the grid. Use `costs()` and `components()` to read the snapshot in
+   * place.
+   *
+   * \return The grid, with its connected components already labeled if they were saved.
+   */
+  std::shared_ptr<Grid> grid() const;
+
+  /**
+   * Get the width of the grid.
+   *
+   * \return The width, or 0 if nothing is open.
+   */
+  int width() const;
+
+  /**
+   * Get the height of the grid.
+   *
+   * \return The height, or 0 if nothing is open.
+   */
+  int height() const;
+
+  /**
+   * Get the start cell.
+   *
+   * \return The index of the start cell, or -1 if there is none.
+   */
+  int start() const;
+
+  /**
+   * Get the goal cell.
+   *
+   * \return The index of the goal cell, or -1 if there is none.
+   */
+  int goal() const;
+
+  /**
+   * Get the costs of the cells, straight from the file.
+   *
+   * \return One byte per cell, indexed `y * width + x`, with 0 for a wall.
+   */
+  const uint8_t* costs() const;
+
+  /**
+   * Get the saved connected components, straight from the file.
+   *
+   * \return The representative of every cell's component, or nullptr if they weren't
+   *         saved.
+   */
+  const int32_t* components() const;
+
+  /**
+   * Check whether a path names a snapshot file, by its extension.
+   *
+   * \param path The path.
+   * \return True if the path ends in `.grid`.
+   */
+  static bool isSnapshotPath(const std::string& path);
+
+  private:
+
+  /**
+   * The header at the start of every snapshot.
+   */
+  struct Header {
+    char magic[8]; // Identifies the file as a snapshot.
+    uint32_t version; // The version of the format.
+    uint32_t byteOrder; // BYTE_ORDER_MARK, which reads differently if swapped.
+    uint32_t flags; // Which optional tables are present.
+    int32_t width; // The width of the grid.
+    int32_t height; // The height of the grid.
+    int32_t start; // The index of the start cell, or -1.
+    int32_t goal; // The index of the goal cell, or -1.
+    uint32_t reserved; // Zero, keeping the offsets aligned.
+    uint64_t costsOffset; // Where the cost table starts.
+    uint64_t componentsOffset; // Where the components table starts, if present.
+  };
+  static_assert(sizeof(Header) == 56, "The header must not be padded.");
+
+  static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304; // Detects swapped bytes.
+  static constexpr uint32_t HAS_COMPONENTS = 1; // Flags a saved components table.
+
+  /**
+   * Close the snapshot, if one is open.
+   */
+  void close();
+
+  /*
+   * Data.
+   */
+
+  const char* data_ = nullptr; // The contents of the file.
+  size_t size_ = 0; // The size of the file.
+  bool mapped_ = false; // Whether the contents are mapped rather than read in.
+  std::vector<char> buffer_; // The contents, where files can't be mapped.
+  Header header_; // A copy of the file's header.
+};
+
+#endif
\ No newline at end of file
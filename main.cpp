@@ -1,12 +1,14 @@
 #include <QApplication>
 
 #include "mainwindow.h"
+#include "profiler.h"
 
 int main(int argc, char* argv[])
 {
   QApplication a(argc, argv);
+  Profiler::singleton().nameThread("GUI");
   MainWindow w;
   w.setWindowTitle("Search Visualizer");
   w.show();
   return a.exec();
-}
+}
\ No newline at end of file
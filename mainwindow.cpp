@@ -8,6 +8,7 @@ MainWindow::MainWindow(QWidget* parent)
 {
   // Create the graphics area.
   graphicsArea = new GraphicsArea(400, 400, this);
+  traceControls = new TraceControls(this);
 
   // Create the tab widget.
   tabWidget = new QTabWidget(this);
@@ -17,17 +18,30 @@ MainWindow::MainWindow(QWidget* parent)
   editTab = new EditTab(this);
   astarTab = new AStarTab(this);
   dijkstraTab = new DijkstraTab(this);
+  hdaStarTab = new HDAStarTab(this);
+  subgoalTab = new SubgoalTab(this);
+  fringeTab = new FringeTab(this);
+  thetaStarTab = new ThetaStarTab(GlobalState::SimType::THETA_STAR, this);
+  lazyThetaStarTab = new ThetaStarTab(GlobalState::SimType::LAZY_THETA_STAR, this);
 
   // Add the tabs to the tab widget.
   tabWidget->addTab(editTab, "Edit");
   tabWidget->addTab(astarTab, "A*");
   tabWidget->addTab(dijkstraTab, "Dijkstra");
+  tabWidget->addTab(hdaStarTab, "HDA*");
+  tabWidget->addTab(subgoalTab, "SUB");
+  tabWidget->addTab(fringeTab, "Fringe");
+  tabWidget->addTab(thetaStarTab, "Theta*");
+  tabWidget->addTab(lazyThetaStarTab, "Lazy Theta*");
 
   // Create the layout.
   layout = new QHBoxLayout(this);
 
   // Add the graphics area and tab widget to the layout.
-  layout->addWidget(graphicsArea, 1);
+  graphicsLayout = new QVBoxLayout();
+  graphicsLayout->addWidget(graphicsArea, 1);
+  graphicsLayout->addWidget(traceControls, 0);
+  layout->addLayout(graphicsLayout, 1);
   layout->addWidget(tabWidget, 0);
 
   // Set the layout.
@@ -46,9 +60,20 @@ MainWindow::MainWindow(QWidget* parent)
       &GraphicsArea::setGoalCellSelected);
   QObject::connect(
       editTab, &EditTab::resetGrid, graphicsArea, &GraphicsArea::resetGrid);
+  QObject::connect(editTab, &EditTab::loadMap, graphicsArea, &GraphicsArea::loadMap);
+  QObject::connect(
+      editTab, &EditTab::saveSnapshot, graphicsArea, &GraphicsArea::saveSnapshot);
+  QObject::connect(
+      editTab, &EditTab::loadSnapshot, graphicsArea, &GraphicsArea::loadSnapshot);
+  QObject::connect(
+      editTab, &EditTab::generateMap, graphicsArea, &GraphicsArea::generateMap);
+  QObject::connect(editTab, &EditTab::showPrunedRegions, graphicsArea,
+      &GraphicsArea::setPrunedOverlay);
+  QObject::connect(
+      traceControls, &TraceControls::loadTrace, graphicsArea, &GraphicsArea::loadTrace);
 
   // Make sure game loop is initialized.
   GameLoop::singleton();
 }
 
-MainWindow::~MainWindow() { }
+MainWindow::~MainWindow() { }
\ No newline at end of file
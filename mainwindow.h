@@ -3,12 +3,18 @@
 
 #include <QHBoxLayout>
 #include <QTabWidget>
+#include <QVBoxLayout>
 #include <QWidget>
 
 #include "widgets/astar_tab.h"
 #include "widgets/dijkstra_tab.h"
 #include "widgets/edit_tab.h"
+#include "widgets/fringe_tab.h"
 #include "widgets/graphics_area.h"
+#include "widgets/hda_star_tab.h"
+#include "widgets/subgoal_tab.h"
+#include "widgets/theta_star_tab.h"
+#include "widgets/trace_controls.h"
 
 /**
  * The main window of the application.
@@ -37,7 +43,9 @@ class MainWindow : public QWidget {
    */
 
   QHBoxLayout* layout; // The layout of the main window.
+  QVBoxLayout* graphicsLayout; // The layout of the graphics area and its controls.
   GraphicsArea* graphicsArea; // The graphics area.
+  TraceControls* traceControls; // The controls for the trace of a search.
   QTabWidget* tabWidget; // The widget holding the tabs.
 
   /*
@@ -47,6 +55,11 @@ class MainWindow : public QWidget {
   EditTab* editTab; // The edit tab.
   AStarTab* astarTab; // The A* tab.
   DijkstraTab* dijkstraTab; // The Dijkstra tab.
+  HDAStarTab* hdaStarTab; // The HDA* tab.
+  SubgoalTab* subgoalTab; // The subgoal graph tab.
+  FringeTab* fringeTab; // The Fringe Search tab.
+  ThetaStarTab* thetaStarTab; // The Theta* tab.
+  ThetaStarTab* lazyThetaStarTab; // The Lazy Theta* tab.
 };
 
-#endif // MAINWINDOW_H
+#endif // MAINWINDOW_H
\ No newline at end of file
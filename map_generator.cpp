@@ -0,0 +1,566 @@
+#include "map_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "profiler.h"
+
+namespace MapGenerator {
+
+namespace {
+
+using Cell = Grid::Cell;
+
+constexpr unsigned int WALL_COST = Cell::WALL_COST; // The cost of a wall cell.
+
+constexpr unsigned int PASSABLE_COST = 1; // The cost of a plain passable cell.
+constexpr int NOISE_SCALE = 64; // The size of the coarsest features of a noise field.
+constexpr int NOISE_OCTAVES = 4; // The number of layers of ever finer noise.
+constexpr double NOISE_SPREAD = 0.17; // The standard deviation of the summed noise.
+constexpr int ROOM_TILE = 16; // The rough size of the tile that each room is placed in.
+constexpr int CITY_BLOCK = 16; // The distance between streets.
+constexpr int STREET_WIDTH = 2; // The width of a street.
+constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15ULL; // The SplitMix64 increment.
+
+// Keep the random numbers of each use apart, so that layouts don't echo each other.
+constexpr uint64_t OBSTACLE_STREAM = 1 << 8;
+constexpr uint64_t MAZE_STREAM = 2 << 8;
+constexpr uint64_t NOISE_STREAM = 3 << 8; // Plus the octave.
+constexpr uint64_t ROOM_STREAM = 4 << 8;
+constexpr uint64_t CITY_STREAM = 5 << 8;
+
+/**
+ * Scramble the bits of a number, as the output step of SplitMix64 does.
+ *
+ * \param z The number.
+ * \return The scrambled number.
+ */
+uint64_t scramble(uint64_t z)
+{
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * Hash a seed and a pair of coordinates.
+ *
+ * \param seed The seed of the map.
+ * \param stream What the hash is used for.
+ * \param a The first coordinate.
+ * \param b The second coordinate.
+ * \return The hash.
+ */
+uint64_t hash(unsigned int seed, uint64_t stream, int a, int b = 0)
+{
+  const uint64_t key = scramble(seed * GOLDEN_GAMMA + stream);
+  return scramble(key ^ ((uint64_t)(uint32_t)a | (uint64_t)(uint32_t)b << 32));
+}
+
+/**
+ * A small random number generator (SplitMix64), whose results are the same everywhere.
+ */
+class Random {
+  public:
+
+  /**
+   * Construct a new Random.
+   *
+   * \param seed The seed, usually from `hash()`.
+   */
+  explicit Random(uint64_t seed)
+      : state_(seed)
+  {
+  }
+
+  /**
+   * Get the next random number.
+   *
+   * \return A random number.
+   */
+  uint64_t next()
+  {
+    state_ += GOLDEN_GAMMA;
+    return scramble(state_);
+  }
+
+  /**
+   * Get a random number below a bound.
+   *
+   * \param bound The bound, which must be positive.
+   * \return A random number from 0 to `bound - 1`.
+   */
+  int below(int bound) { return (int)(((next() >> 32) * (uint64_t)bound) >> 32); }
+
+  /**
+   * Decide something at random.
+   *
+   * \param probability The probability of deciding yes.
+   * \return True with the given probability.
+   */
+  bool chance(double probability)
+  {
+    return (double)(next() >> 11) / 9007199254740992.0 < probability;
+  }
+
+  private:
+
+  uint64_t state_; // The state of the generator.
+};
+
+/**
+ * Fills in one row of a map.
+ */
+using RowFiller
+    = void (*)(const Settings& settings, int y, std::vector<unsigned int>& row);
+
+/**
+ * Fill in a row of scattered walls.
+ * The corners are never walls, so that they are usually where the search runs between.
+ *
+ * \param settings What to generate.
+ * \param y The y coordinate of the row.
+ * \param row Set to the costs of the row.
+ */
+void obstaclesRow(const Settings& settings, int y, std::vector<unsigned int>& row)
+{
+  Random random(hash(settings.seed, OBSTACLE_STREAM, y));
+  for (int x = 0; x < settings.width; x++) {
+    const bool wall = random.chance(settings.density);
+    const unsigned int cost = PASSABLE_COST + random.below((int)settings.maxCost);
+    row[x] = wall ? WALL_COST : cost;
+  }
+  if (y == 0 && row[0] == WALL_COST) {
+    row[0] = PASSABLE_COST;
+  }
+  if (y == settings.height - 1 && row[settings.width - 1] == WALL_COST) {
+    row[settings.width - 1] = PASSABLE_COST;
+  }
+}
+
+/**
+ * Carve one row of a sidewinder maze.
+ * The top row of the maze is one long corridor. Every other row is split at random
+ * into runs of cells joined east to west, and each run is joined to the row above at
+ * one of its cells.
+ *
+ * \param settings What to generate.
+ * \param mazeY The row of the maze.
+ * \param east Set to whether each cell of the row is joined to the cell east of it.
+ * \param north Set to whether each cell of the row is joined to the cell above it.
+ */
+void carveMazeRow(const Settings& settings, int mazeY, std::vector<bool>& east,
+    std::vector<bool>& north)
+{
+  const int cells = (settings.width + 1) / 2;
+  east.assign(cells, false);
+  north.assign(cells, false);
+  if (mazeY == 0) {
+    std::fill(east.begin(), east.end() - 1, true);
+    return;
+  }
+
+  Random random(hash(settings.seed, MAZE_STREAM, mazeY));
+  int runStart = 0;
+  for (int x = 0; x < cells; x++) {
+    if (x == cells - 1 || random.chance(0.5)) {
+      north[runStart + random.below(x - runStart + 1)] = true;
+      runStart = x + 1;
+    } else {
+      east[x] = true;
+    }
+  }
+}
+
+/**
+ * Fill in a row of a maze.
+ * The maze's cells are the map's cells with even coordinates, and the map's other
+ * cells are the walls between them, unless the maze joins the cells on either side.
+ *
+ * \param settings What to generate.
+ * \param y The y coordinate of the row.
+ * \param row Set to the costs of the row.
+ */
+void mazeRow(const Settings& settings, int y, std::vector<unsigned int>& row)
+{
+  std::fill(row.begin(), row.end(), WALL_COST);
+
+  // An odd row of the map holds the joins from the maze row below it to the one above.
+  const int mazeY = (y + 1) / 2;
+  if (mazeY >= (settings.height + 1) / 2) {
+    return; // The last row of a map of even height, which has no maze row below it.
+  }
+  std::vector<bool> east, north;
+  carveMazeRow(settings, mazeY, east, north);
+  for (int x = 0; x < settings.width; x++) {
+    const bool open
+        = y % 2 == 0 ? x % 2 == 0 || east[x / 2] : x % 2 == 0 && north[x / 2];
+    if (open) {
+      row[x] = PASSABLE_COST;
+    }
+  }
+}
+
+/**
+ * Get the slope of the noise at a lattice point, towards a point near it.
+ * The slopes are the eight of Perlin's improved noise, picked by hashing the point.
+ *
+ * \param settings What to generate.
+ * \param octave The layer of noise.
+ * \param x The x coordinate of the lattice point.
+ * \param y The y coordinate of the lattice point.
+ * \param dx How far east of the lattice point the nearby point is.
+ * \param dy How far south of the lattice point the nearby point is.
+ * \return The slope.
+ */
+double slope(const Settings& settings, int octave, int x, int y, double dx, double dy)
+{
+  switch (hash(settings.seed, NOISE_STREAM + octave, x, y) & 7) {
+  case 0:
+    return dx + dy;
+  case 1:
+    return dx - dy;
+  case 2:
+    return -dx + dy;
+  case 3:
+    return -dx - dy;
+  case 4:
+    return dx;
+  case 5:
+    return -dx;
+  case 6:
+    return dy;
+  default:
+    return -dy;
+  }
+}
+
+/**
+ * Get Perlin noise at a point.
+ *
+ * \param settings What to generate.
+ * \param octave The layer of noise.
+ * \param x The x coordinate of the point, in lattice units.
+ * \param y The y coordinate of the point, in lattice units.
+ * \return The noise, from about -1 to 1.
+ */
+double perlin(const Settings& settings, int octave, double x, double y)
+{
+  const int left = (int)std::floor(x);
+  const int top = (int)std::floor(y);
+  const double dx = x - left;
+  const double dy = y - top;
+  auto fade = [](double t) { return t * t * t * (t * (t * 6 - 15) + 10); };
+  auto mix = [](double a, double b, double t) { return a + (b - a) * t; };
+  const double u = fade(dx);
+  const double v = fade(dy);
+  const double upper = mix(slope(settings, octave, left, top, dx, dy),
+      slope(settings, octave, left + 1, top, dx - 1, dy), u);
+  const double lower = mix(slope(settings, octave, left, top + 1, dx, dy - 1),
+      slope(settings, octave, left + 1, top + 1, dx - 1, dy - 1), u);
+  return mix(upper, lower, v);
+}
+
+/**
+ * Fill in a row of a noise field.
+ *
+ * \param settings What to generate.
+ * \param y The y coordinate of the row.
+ * \param row Set to the costs of the row.
+ */
+void noiseRow(const Settings& settings, int y, std::vector<unsigned int>& row)
+{
+  for (int x = 0; x < settings.width; x++) {
+    // Sum ever finer layers of noise, sampling the middle of the cell.
+    double noise = 0;
+    double amplitude = 1;
+    double total = 0;
+    double scale = NOISE_SCALE;
+    for (int octave = 0; octave < NOISE_OCTAVES; octave++) {
+      noise
+          += amplitude * perlin(settings, octave, (x + 0.5) / scale, (y + 0.5) / scale);
+      total += amplitude;
+      amplitude /= 2;
+      scale /= 2;
+    }
+
+    // Summed noise is spread roughly normally, so its distribution evens it out.
+    const double spread = noise / total / (NOISE_SPREAD * std::sqrt(2.0));
+    const double level = 0.5 * (1 + std::erf(spread));
+    if (level < settings.density) {
+      row[x] = WALL_COST;
+    } else {
+      const double height = (level - settings.density) / (1 - settings.density);
+      const unsigned int step
+          = std::min(settings.maxCost - 1, (unsigned int)(height * settings.maxCost));
+      row[x] = PASSABLE_COST + step;
+    }
+  }
+}
+
+/**
+ * A room, as inclusive bounds.
+ */
+struct Room {
+  int left, top, right, bottom; // The bounds of the room.
+  int centerX, centerY; // The cell that corridors leave the room from.
+};
+
+/**
+ * Get where a tile of a lattice starts along one axis.
+ * The map is split into tiles of as equal sizes as possible.
+ *
+ * \param tile The tile.
+ * \param tiles The number of tiles.
+ * \param size The size of the map.
+ * \return The first coordinate in the tile.
+ */
+int tileStart(int tile, int tiles, int size)
+{
+  return (int)((int64_t)tile * size / tiles);
+}
+
+/**
+ * Place a span of random length inside a tile along one axis, keeping off its edges.
+ *
+ * \param random The random number generator of the room.
+ * \param start The first coordinate in the tile.
+ * \param size The size of the tile.
+ * \param low Set to the first coordinate of the span.
+ * \param high Set to the last coordinate of the span.
+ */
+void placeSpan(Random& random, int start, int size, int& low, int& high)
+{
+  const int margin = size > 2 ? 1 : 0;
+  const int space = size - 2 * margin;
+  const int length = (space + 1) / 2 + random.below(space / 2 + 1);
+  low = start + margin + random.below(space - length + 1);
+  high = low + length - 1;
+}
+
+/**
+ * Get the room in a tile.
+ *
+ * \param settings What to generate.
+ * \param tilesX The number of tiles across the map.
+ * \param tilesY The number of tiles down the map.
+ * \param tileX The column of the tile.
+ * \param tileY The row of the tile.
+ * \return The room.
+ */
+Room room(const Settings& settings, int tilesX, int tilesY, int tileX, int tileY)
+{
+  Random random(hash(settings.seed, ROOM_STREAM, tileX, tileY));
+  const int left = tileStart(tileX, tilesX, settings.width);
+  const int top = tileStart(tileY, tilesY, settings.height);
+  Room room;
+  const int right = tileStart(tileX + 1, tilesX, settings.width);
+  const int bottom = tileStart(tileY + 1, tilesY, settings.height);
+  placeSpan(random, left, right - left, room.left, room.right);
+  placeSpan(random, top, bottom - top, room.top, room.bottom);
+  room.centerX = (room.left + room.right) / 2;
+  room.centerY = (room.top + room.bottom) / 2;
+  return room;
+}
+
+/**
+ * Open up the cells of a row that a corridor between two rooms runs through.
+ * The corridor runs across from the first room, then up or down into the second.
+ *
+ * \param from The room the corridor starts in.
+ * \param to The room the corridor ends in.
+ * \param y The y coordinate of the row.
+ * \param row The costs of the row.
+ */
+void openCorridor(
+    const Room& from, const Room& to, int y, std::vector<unsigned int>& row)
+{
+  if (y == from.centerY) {
+    std::fill(row.begin() + std::min(from.centerX, to.centerX),
+        row.begin() + std::max(from.centerX, to.centerX) + 1, PASSABLE_COST);
+  }
+  if (y >= std::min(from.centerY, to.centerY)
+      && y <= std::max(from.centerY, to.centerY)) {
+    row[to.centerX] = PASSABLE_COST;
+  }
+}
+
+/**
+ * Fill in a row of rooms and corridors.
+ * Every room is joined to the rooms east and south of it, so all of them are reachable.
+ *
+ * \param settings What to generate.
+ * \param y The y coordinate of the row.
+ * \param row Set to the costs of the row.
+ */
+void roomsRow(const Settings& settings, int y, std::vector<unsigned int>& row)
+{
+  std::fill(row.begin(), row.end(), WALL_COST);
+  const int tilesX = std::max(1, settings.width / ROOM_TILE);
+  const int tilesY = std::max(1, settings.height / ROOM_TILE);
+  int tileY = (int)((int64_t)y * tilesY / settings.height);
+  while (tileY + 1 < tilesY && tileStart(tileY + 1, tilesY, settings.height) <= y) {
+    tileY++;
+  }
+
+  // Corridors going south can reach down from the row of tiles above.
+  for (int fromY = std::max(0, tileY - 1); fromY <= tileY; fromY++) {
+    for (int tileX = 0; tileX < tilesX; tileX++) {
+      const Room from = room(settings, tilesX, tilesY, tileX, fromY);
+      if (fromY == tileY && y >= from.top && y <= from.bottom) {
+        std::fill(
+            row.begin() + from.left, row.begin() + from.right + 1, PASSABLE_COST);
+      }
+      if (fromY == tileY && tileX + 1 < tilesX) {
+        openCorridor(from, room(settings, tilesX, tilesY, tileX + 1, fromY), y, row);
+      }
+      if (fromY + 1 < tilesY) {
+        openCorridor(from, room(settings, tilesX, tilesY, tileX, fromY + 1), y, row);
+      }
+    }
+  }
+}
+
+/**
+ * Fill in a row of city blocks.
+ * A block that is built up is a wall, unless an alley runs across or down it from one
+ * street to the next. A block that isn't is an open lot.
+ *
+ * \param settings What to generate.
+ * \param y The y coordinate of the row.
+ * \param row Set to the costs of the row.
+ */
+void cityRow(const Settings& settings, int y, std::vector<unsigned int>& row)
+{
+  const int blockY = y / CITY_BLOCK;
+  const int insideY = y % CITY_BLOCK;
+  for (int left = 0; left < settings.width; left += CITY_BLOCK) {
+    Random random(hash(settings.seed, CITY_STREAM, left / CITY_BLOCK, blockY));
+    const bool built = random.chance(settings.density);
+    const int alley = random.below(3); // None, across or down.
+    const int alleyAt = STREET_WIDTH + random.below(CITY_BLOCK - STREET_WIDTH);
+
+    const int right = std::min(settings.width, left + CITY_BLOCK);
+    for (int x = left; x < right; x++) {
+      const int insideX = x - left;
+      const bool street = insideX < STREET_WIDTH || insideY < STREET_WIDTH;
+      const bool open = street || !built || (alley == 1 && insideY == alleyAt)
+          || (alley == 2 && insideX == alleyAt);
+      row[x] = open ? PASSABLE_COST : WALL_COST;
+    }
+  }
+}
+
+/**
+ * Get what fills in the rows of a layout.
+ *
+ * \param layout The layout.
+ * \return The row filler.
+ */
+RowFiller rowFiller(Layout layout)
+{
+  switch (layout) {
+  case Layout::MAZE:
+    return mazeRow;
+  case Layout::NOISE:
+    return noiseRow;
+  case Layout::ROOMS:
+    return roomsRow;
+  case Layout::CITY:
+    return cityRow;
+  case Layout::OBSTACLES:
+    break;
+  }
+  return obstaclesRow;
+}
+}
+
+Map generate(const Settings& settings)
+{
+  PROFILE_SCOPE("MapGenerator::generate");
+
+  Settings checked = settings;
+  checked.maxCost = std::max(PASSABLE_COST, settings.maxCost);
+  const int width = checked.width;
+  const int height = checked.height;
+  Map map;
+  map.grid = std::make_shared<Grid>(width, height);
+
+  // Each thread fills in its own band of rows.
+  const RowFiller fill = rowFiller(checked.layout);
+  auto band = [&](int first, int last) {
+    std::vector<unsigned int> row(width);
+    for (int y = first; y < last; y++) {
+      fill(checked, y, row);
+      map.grid->setRowCosts(y, row);
+    }
+  };
+  int threads = checked.threads;
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads = std::max(1, std::min(threads, height));
+  std::vector<std::thread> workers;
+  for (int i = 1; i < threads; i++) {
+    workers.emplace_back(band, i * height / threads, (i + 1) * height / threads);
+  }
+  band(0, height / threads);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // Search across the largest connected region, so that a path always exists.
+  map.grid->largestRegionEnds(map.start, map.goal);
+  return map;
+}
+
+std::string describe(const Settings& settings)
+{
+  std::ostringstream description;
+  description << layoutName(settings.layout) << " " << settings.width << "x"
+              << settings.height;
+  const Layout layout = settings.layout;
+  const bool costs = layout == Layout::OBSTACLES || layout == Layout::NOISE;
+  if (costs || layout == Layout::CITY) {
+    description << ", density " << settings.density;
+  }
+  if (costs && settings.maxCost > 1) {
+    description << ", costs up to " << settings.maxCost;
+  }
+  description << ", seed " << settings.seed;
+  return description.str();
+}
+
+const char* layoutName(Layout layout)
+{
+  switch (layout) {
+  case Layout::OBSTACLES:
+    return "obstacles";
+  case Layout::MAZE:
+    return "maze";
+  case Layout::NOISE:
+    return "noise";
+  case Layout::ROOMS:
+    return "rooms";
+  case Layout::CITY:
+    return "city";
+  }
+  return "";
+}
+
+bool layoutNamed(const std::string& name, Layout& layout)
+{
+  for (Layout candidate :
+      { Layout::OBSTACLES, Layout::MAZE, Layout::NOISE, Layout::ROOMS, Layout::CITY }) {
+    if (name == layoutName(candidate)) {
+      layout = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace MapGenerator
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef MAP_GENERATOR_H
+#define MAP_GENERATOR_H
+
+#include <memory>
+#include <string>
+
+#include "grid.h"
+
+/**
+ * Seeded procedural maps for stress-testing the search engines.
+ *
+ * Every cell is a pure function of the seed and its coordinates, so a map is filled in
+ * bands of rows on several threads and still comes out the same however many threads
+ * there are. Random numbers come from a hash of the seed rather than from the standard
+ * library's distributions, whose results differ between implementations, so a seed
+ * gives the same map on every platform.
+ *
+ * The layouts are:
+ * - obstacles: walls scattered at random, a `density` fraction of the cells.
+ * - maze: a perfect maze with one-cell corridors, carved with the sidewinder
+ *   algorithm, which decides each row of the maze on its own.
+ * - noise: a field of Perlin noise, where the lowest `density` fraction of the noise is
+ *   walls and the rest rises from the cheapest cost to `maxCost`.
+ * - rooms: a room in each tile of a coarse lattice, joined to its neighbors by
+ *   corridors so that every room can be reached.
+ * - city: streets on a regular lattice, with a `density` fraction of the blocks built
+ *   up, some of them with an alley through.
+ */
+namespace MapGenerator {
+
+/**
+ * The layout of a map.
+ */
+enum class Layout { OBSTACLES, MAZE, NOISE, ROOMS, CITY };
+
+/**
+ * What to generate.
+ */
+struct Settings {
+  Layout layout = Layout::OBSTACLES; // The layout of the map.
+  int width = 256; // The width of the map.
+  int height = 256; // The height of the map.
+  unsigned int seed = 1; // The seed that the map is generated from.
+  double density = 0.2; // How built up the map is, as described for each layout.
+  unsigned int maxCost = 1; // The most a passable cell costs (obstacles and noise).
+  int threads = 0; // The number of threads to fill the map on (0 for one per core).
+};
+
+/**
+ * A generated map.
+ */
+struct Map {
+  std::shared_ptr<Grid> grid; // The map.
+  int start = -1; // The index of the start cell, or -1 if there is none.
+  int goal = -1; // The index of the goal cell, or -1 if there is none.
+};
+
+/**
+ * Generate a map.
+ *
+ * \param settings What to generate.
+ * \return The map. Its start and goal are the first and last cells of its largest
+ *         connected region, so a path always exists between them. They are -1 if no
+ *         two passable cells are connected.
+ */
+Map generate(const Settings& settings);
+
+/**
+ * Describe a map well enough to generate it again.
+ *
+ * \param settings What was generated.
+ * \return A description that includes the layout, size and seed.
+ */
+std::string describe(const Settings& settings);
+
+/**
+ * Get the name of a layout.
+ *
+ * \param layout The layout.
+ * \return The name of the layout, as on the command line.
+ */
+const char* layoutName(Layout layout);
+
+/**
+ * Get a layout by its name.
+ *
+ * \param name The name of the layout.
+ * \param layout Set to the layout.
+ * \return False if there is no layout with that name.
+ */
+bool layoutNamed(const std::string& name, Layout& layout);
+}
+
+#endif
\ No newline at end of file
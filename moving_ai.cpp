@@ -0,0 +1,178 @@
+#include "moving_ai.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace MovingAI {
+
+namespace {
+
+constexpr int MAX_SIDE = 1 << 15; // The largest width or height that is accepted.
+constexpr unsigned int PASSABLE_COST = 1; // The cost of every passable cell.
+
+/**
+ * Check whether a string ends with a suffix.
+ *
+ * \param text The string.
+ * \param suffix The suffix.
+ * \return True if the string ends with the suffix.
+ */
+bool endsWith(const std::string& text, const std::string& suffix)
+{
+  return text.size() >= suffix.size()
+      && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * Read a line, dropping the carriage return of a Windows line ending.
+ *
+ * \param in The stream to read from.
+ * \param line Set to the line.
+ * \return False if there are no more lines.
+ */
+bool readLine(std::istream& in, std::string& line)
+{
+  if (!std::getline(in, line)) {
+    return false;
+  }
+  if (!line.empty() && line.back() == '\r') {
+    line.pop_back();
+  }
+  return true;
+}
+}
+
+bool terrainCost(char terrain, unsigned int& cost)
+{
+  switch (terrain) {
+  case '.': // Passable terrain.
+  case 'G':
+  case 'S': // Swamp, which is passable from passable terrain.
+    cost = PASSABLE_COST;
+    return true;
+  case '@': // Out of bounds.
+  case 'O':
+  case 'T': // Trees.
+  case 'W': // Water, which can only be entered from water.
+    cost = Grid::Cell::WALL_COST;
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool loadMap(std::istream& in, std::shared_ptr<Grid>& grid)
+{
+  // Read the header, whose lines can come in any order before `map`.
+  int width = 0;
+  int height = 0;
+  std::string line;
+  while (true) {
+    if (!readLine(in, line)) {
+      return false;
+    }
+    std::istringstream fields(line);
+    std::string key;
+    fields >> key;
+    if (key == "map") {
+      break;
+    } else if (key == "width") {
+      fields >> width;
+    } else if (key == "height") {
+      fields >> height;
+    } else if (key != "type" && !key.empty()) {
+      return false;
+    }
+    if (!fields && !fields.eof()) {
+      return false;
+    }
+  }
+  if (width < 1 || height < 1 || width > MAX_SIDE || height > MAX_SIDE) {
+    return false;
+  }
+
+  // Read the rows straight into a new grid.
+  std::shared_ptr<Grid> map = std::make_shared<Grid>(width, height);
+  std::vector<unsigned int> costs(width);
+  for (int y = 0; y < height; y++) {
+    if (!readLine(in, line) || (int)line.size() != width) {
+      return false;
+    }
+    for (int x = 0; x < width; x++) {
+      if (!terrainCost(line[x], costs[x])) {
+        return false;
+      }
+    }
+    map->setRowCosts(y, costs);
+  }
+
+  grid = map;
+  return true;
+}
+
+bool loadMap(const std::string& path, std::shared_ptr<Grid>& grid)
+{
+  std::ifstream in(path);
+  return in && loadMap(in, grid);
+}
+
+bool loadScenarios(const std::string& path, std::vector<Scenario>& scenarios)
+{
+  std::ifstream in(path);
+  std::string line;
+  if (!in || !readLine(in, line) || line.compare(0, 7, "version") != 0) {
+    return false;
+  }
+
+  std::vector<Scenario> read;
+  while (readLine(in, line)) {
+    std::istringstream fields(line);
+    Scenario scenario;
+    if (!(fields >> scenario.bucket)) {
+      if (fields.eof()) {
+        continue; // A blank line.
+      }
+      return false;
+    }
+    if (!(fields >> scenario.map >> scenario.mapWidth >> scenario.mapHeight
+            >> scenario.startX >> scenario.startY >> scenario.goalX >> scenario.goalY
+            >> scenario.optimalLength)) {
+      return false;
+    }
+    const bool inside = scenario.startX >= 0 && scenario.startX < scenario.mapWidth
+        && scenario.goalX >= 0 && scenario.goalX < scenario.mapWidth
+        && scenario.startY >= 0 && scenario.startY < scenario.mapHeight
+        && scenario.goalY >= 0 && scenario.goalY < scenario.mapHeight;
+    if (!inside) {
+      return false;
+    }
+    read.push_back(scenario);
+  }
+
+  scenarios.swap(read);
+  return true;
+}
+
+std::string mapPath(const std::string& scenarioPath, const Scenario& scenario)
+{
+  const size_t slash = scenarioPath.find_last_of("/\\");
+  const std::string directory
+      = slash == std::string::npos ? "" : scenarioPath.substr(0, slash + 1);
+  const size_t nameStart = scenario.map.find_last_of("/\\");
+  const std::string name = nameStart == std::string::npos
+      ? scenario.map
+      : scenario.map.substr(nameStart + 1);
+
+  for (const std::string& candidate : { directory + scenario.map, directory + name }) {
+    std::ifstream file(candidate);
+    if (file) {
+      return candidate;
+    }
+  }
+  return "";
+}
+
+bool isMapPath(const std::string& path) { return endsWith(path, ".map"); }
+
+bool isScenarioPath(const std::string& path) { return endsWith(path, ".scen"); }
+} // namespace MovingAI
\ No newline at end of file
@@ -0,0 +1,107 @@
+#ifndef MOVING_AI_H
+#define MOVING_AI_H
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "grid.h"
+
+/**
+ * Import of the Moving AI Lab's grid benchmark maps and scenarios.
+ *
+ * A map file has a short header (`type octile`, `height H`, `width W`, `map`) followed
+ * by one line of terrain characters per row. Passable terrain (`.`, `G`, `S`) becomes
+ * the cheapest cell cost, and everything else the benchmarks treat as blocked (`@`,
+ * `O`, `T`, `W`) becomes a wall. Maps are read a row at a time, so even the largest
+ * benchmark maps are never held in memory twice.
+ *
+ * A scenario file lists queries on a map, one per line after a `version` line: a
+ * bucket, the map's file name, the map's size, the start and goal coordinates, and the
+ * optimal path length. The published lengths allow diagonal moves, which this grid does
+ * not, so they are a lower bound on the costs found here rather than something to
+ * match.
+ */
+namespace MovingAI {
+
+/**
+ * A query from a scenario file.
+ */
+struct Scenario {
+  int bucket = 0; // The bucket, which groups queries of similar length.
+  std::string map; // The file name of the map, as given in the scenario file.
+  int mapWidth = 0; // The width of the map.
+  int mapHeight = 0; // The height of the map.
+  int startX = 0; // The x coordinate of the start cell.
+  int startY = 0; // The y coordinate of the start cell.
+  int goalX = 0; // The x coordinate of the goal cell.
+  int goalY = 0; // The y coordinate of the goal cell.
+  double optimalLength = 0; // The published optimal length, with diagonal moves.
+};
+
+/**
+ * Get the cost of a terrain character.
+ *
+ * \param terrain The terrain character.
+ * \param cost Set to the cost of the terrain.
+ * \return False if the character is not a known terrain.
+ */
+bool terrainCost(char terrain, unsigned int& cost);
+
+/**
+ * Read a map.
+ *
+ * \param in The stream to read the map from.
+ * \param grid Set to a new grid holding the map, if it is read.
+ * \return False if the map is not valid, in which case the grid is left unchanged.
+ */
+bool loadMap(std::istream& in, std::shared_ptr<Grid>& grid);
+
+/**
+ * Read a map from a file.
+ *
+ * \param path The path of the map file.
+ * \param grid Set to a new grid holding the map, if it is read.
+ * \return False if the file can't be read or is not a valid map.
+ */
+bool loadMap(const std::string& path, std::shared_ptr<Grid>& grid);
+
+/**
+ * Read the queries of a scenario file.
+ *
+ * \param path The path of the scenario file.
+ * \param scenarios Set to the queries, if they are read.
+ * \return False if the file can't be read or is not a valid scenario file.
+ */
+bool loadScenarios(const std::string& path, std::vector<Scenario>& scenarios);
+
+/**
+ * Find the map of a scenario.
+ * Scenario files name their map either on its own or with the dataset's directory in
+ * front, so both are looked for next to the scenario file.
+ *
+ * \param scenarioPath The path of the scenario file.
+ * \param scenario A query from the file.
+ * \return The path of the map file, or an empty string if it can't be found.
+ */
+std::string mapPath(const std::string& scenarioPath, const Scenario& scenario);
+
+/**
+ * Check whether a path names a map file, by its extension.
+ *
+ * \param path The path.
+ * \return True if the path ends in `.map`.
+ */
+bool isMapPath(const std::string& path);
+
+/**
+ * Check whether a path names a scenario file, by its extension.
+ *
+ * \param path The path.
+ * \return True if the path ends in `.scen`.
+ */
+bool isScenarioPath(const std::string& path);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+constexpr size_t Profiler::RING_CAPACITY;
+
+namespace {
+
+/**
+ * Quote a string for JSON.
+ *
+ * \param text The string.
+ * \return The quoted string.
+ */
+std::string quote(const std::string& text)
+{
+  std::string quoted = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+    }
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+}
+
+Profiler& Profiler::singleton()
+{
+  static Profiler instance;
+  return instance;
+}
+
+Profiler::Profiler()
+    : epoch_(Clock::now())
+    , enabled_(false)
+    , since_(0)
+{
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+  if (enabled) {
+    since_.store(now(), std::memory_order_relaxed);
+  }
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::nameThread(const std::string& name)
+{
+  const uint32_t thread = claim().thread;
+  std::lock_guard<std::mutex> lock(ringsMutex_);
+  threadNames_[thread] = name;
+}
+
+bool Profiler::save(const std::string& path) const
+{
+  std::ofstream out(path);
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+
+  std::lock_guard<std::mutex> lock(ringsMutex_);
+  bool first = true;
+  for (const auto& name : threadNames_) {
+    out << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", "
+        << "\"pid\": 1, \"tid\": " << name.first
+        << ", \"args\": {\"name\": " << quote(name.second) << "}}";
+    first = false;
+  }
+
+  const int64_t since = since_.load(std::memory_order_relaxed);
+  std::vector<Block> copied(RING_CAPACITY);
+  for (const std::unique_ptr<Ring>& ring : rings_) {
+    // Copy the ring, then throw away every block that its thread might have started
+    // overwriting while it was copied.
+    const uint64_t head = ring->head.load(std::memory_order_acquire);
+    const uint64_t oldest = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+    for (uint64_t i = oldest; i < head; i++) {
+      const Block& block = ring->blocks[i % RING_CAPACITY];
+      Block& copy = copied[i % RING_CAPACITY];
+      copy.name.store(block.name.load(std::memory_order_relaxed));
+      copy.begin.store(block.begin.load(std::memory_order_relaxed));
+      copy.end.store(block.end.load(std::memory_order_relaxed));
+      copy.thread.store(block.thread.load(std::memory_order_relaxed));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = ring->head.load(std::memory_order_relaxed);
+    const uint64_t valid = after >= RING_CAPACITY ? after - RING_CAPACITY + 1 : 0;
+
+    for (uint64_t i = std::max(oldest, valid); i < head; i++) {
+      const Block& block = copied[i % RING_CAPACITY];
+      const int64_t begin = block.begin.load();
+      if (begin < since) {
+        continue;
+      }
+      out << (first ? "" : ",\n") << "{\"name\": " << quote(block.name.load())
+          << ", \"ph\": \"X\", \"ts\": " << begin / 1000.0
+          << ", \"dur\": " << (block.end.load() - begin) / 1000.0
+          << ", \"pid\": 1, \"tid\": " << block.thread.load() << "}";
+      first = false;
+    }
+  }
+
+  out << "\n]}" << std::endl;
+  return (bool)out;
+}
+
+int64_t Profiler::now() const
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch_)
+      .count();
+}
+
+/*
+ * Private.
+ */
+
+Profiler::Claim::~Claim()
+{
+  if (ring != nullptr) {
+    Profiler& profiler = singleton();
+    std::lock_guard<std::mutex> lock(profiler.ringsMutex_);
+    ring->claimed = false;
+  }
+}
+
+void Profiler::record(const char* name, int64_t begin, int64_t end)
+{
+  Claim& claim = this->claim();
+  Ring& ring = *claim.ring;
+  const uint64_t head = ring.head.load(std::memory_order_relaxed);
+  Block& block = ring.blocks[head % RING_CAPACITY];
+
+  // A reader that sees any of the new block must also see the head that came before
+  // it, so that it knows the old block in that slot is being overwritten.
+  std::atomic_thread_fence(std::memory_order_release);
+  block.name.store(name, std::memory_order_relaxed);
+  block.begin.store(begin, std::memory_order_relaxed);
+  block.end.store(end, std::memory_order_relaxed);
+  block.thread.store(claim.thread, std::memory_order_relaxed);
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+Profiler::Claim& Profiler::claim()
+{
+  thread_local Claim claim;
+  if (claim.ring == nullptr) {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    for (const std::unique_ptr<Ring>& ring : rings_) {
+      if (!ring->claimed) {
+        claim.ring = ring.get();
+        break;
+      }
+    }
+    if (claim.ring == nullptr) {
+      rings_.emplace_back(new Ring());
+      claim.ring = rings_.back().get();
+    }
+    claim.ring->claimed = true;
+    claim.thread = nextThread_++;
+  }
+  return claim;
+}
\ No newline at end of file
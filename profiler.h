@@ -0,0 +1,216 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Join two tokens after expanding them, so that each scope gets its own variable name.
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * Time the rest of the enclosing block while the profiler is recording.
+ *
+ * \param name The name of the block, which must be a string literal.
+ */
+#define PROFILE_SCOPE(name)                                                            \
+  Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+/**
+ * Records how long named blocks of code take, for finding out where a frame went.
+ *
+ * Each thread writes the blocks it times into its own fixed-size ring buffer, which
+ * only it writes to, so timing a block takes no locks: two clock reads and a few
+ * relaxed stores. Once a ring is full its oldest blocks are overwritten. A thread
+ * claims a ring the first time it times a block and gives it back when it exits, so
+ * that the rings are reused by threads that are started per search.
+ *
+ * Recording is off until it is turned on, and a block costs one relaxed load while it
+ * is off. The blocks recorded since recording was last turned on can be saved in
+ * Chrome's trace event format, which chrome://tracing and Perfetto open.
+ */
+class Profiler {
+  public:
+
+  static constexpr size_t RING_CAPACITY = 1 << 14; // The blocks kept per thread.
+
+  /**
+   * Times a block from its construction to its destruction.
+   */
+  class Scope {
+    public:
+
+    /**
+     * Start timing a block, if the profiler is recording.
+     *
+     * \param name The name of the block, which must outlive the profiler.
+     */
+    explicit Scope(const char* name);
+
+    /**
+     * Stop timing the block and record it.
+     */
+    ~Scope();
+
+    Scope(Scope const&) = delete;
+    void operator=(Scope const&) = delete;
+
+    private:
+
+    const char* name_; // The name of the block.
+    int64_t begin_; // When the block began (ns), or -1 if it isn't being timed.
+  };
+
+  /**
+   * Get the singleton instance of the Profiler.
+   *
+   * \return The singleton instance of the Profiler.
+   */
+  static Profiler& singleton();
+
+  /**
+   * Construct a new Profiler, which isn't recording.
+   */
+  Profiler();
+
+  /**
+   * Don't allow the Profiler to be copied.
+   */
+  Profiler(Profiler const&) = delete;
+
+  /**
+   * Don't allow the Profiler to be assigned.
+   */
+  void operator=(Profiler const&) = delete;
+
+  /**
+   * Start or stop recording.
+   * Starting again discards the blocks recorded before.
+   *
+   * \param enabled Whether or not to record.
+   */
+  void setEnabled(bool enabled);
+
+  /**
+   * Get whether or not the profiler is recording.
+   *
+   * \return Whether or not the profiler is recording.
+   */
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Name the calling thread in saved traces.
+   *
+   * \param name The name of the thread.
+   */
+  void nameThread(const std::string& name);
+
+  /**
+   * Save the blocks recorded since recording was last started, in Chrome's trace
+   * event format. This can be called while other threads are recording.
+   *
+   * \param path The path of the file to write.
+   * \return True if the file was written.
+   */
+  bool save(const std::string& path) const;
+
+  /**
+   * Get the time since the profiler was constructed.
+   *
+   * \return The time (ns).
+   */
+  int64_t now() const;
+
+  private:
+
+  /**
+   * A timed block.
+   * The fields are atomic so that a ring can be read while its thread writes to it; a
+   * reader throws away any block that might have been overwritten while it was read.
+   */
+  struct Block {
+    std::atomic<const char*> name; // The name of the block.
+    std::atomic<int64_t> begin; // When the block began (ns).
+    std::atomic<int64_t> end; // When the block ended (ns).
+    std::atomic<uint32_t> thread; // The thread that ran the block.
+  };
+
+  /**
+   * The blocks recorded by one thread at a time.
+   */
+  struct Ring {
+    Block blocks[RING_CAPACITY]; // The blocks, indexed by their number modulo capacity.
+    std::atomic<uint64_t> head; // The number of blocks ever written.
+    bool claimed; // Whether a thread is using the ring.
+  };
+
+  /**
+   * A thread's claim on a ring, which gives the ring back when the thread exits.
+   */
+  struct Claim {
+    Ring* ring = nullptr; // The claimed ring, or nullptr if none is claimed yet.
+    uint32_t thread = 0; // The number of the thread.
+
+    ~Claim();
+  };
+
+  /**
+   * Record a timed block on the calling thread's ring.
+   *
+   * \param name The name of the block.
+   * \param begin When the block began (ns).
+   * \param end When the block ended (ns).
+   */
+  void record(const char* name, int64_t begin, int64_t end);
+
+  /**
+   * Get the calling thread's claim, claiming a ring if it doesn't have one.
+   *
+   * \return The claim.
+   */
+  Claim& claim();
+
+  /*
+   * Data.
+   */
+
+  using Clock = std::chrono::steady_clock;
+
+  const Clock::time_point epoch_; // When the profiler was constructed.
+  std::atomic<bool> enabled_; // Whether or not the profiler is recording.
+  std::atomic<int64_t> since_; // When recording was last started (ns).
+  mutable std::mutex ringsMutex_; // Guards the list of rings and the thread names.
+  std::vector<std::unique_ptr<Ring>> rings_; // Every ring, claimed or not.
+  std::map<uint32_t, std::string> threadNames_; // The names given to threads.
+  uint32_t nextThread_ = 1; // The number of the next thread to claim a ring.
+};
+
+/*
+ * The scope is inline, so that a block costs next to nothing while not recording.
+ */
+
+inline Profiler::Scope::Scope(const char* name)
+    : name_(name)
+    , begin_(-1)
+{
+  Profiler& profiler = singleton();
+  if (profiler.enabled()) {
+    begin_ = profiler.now();
+  }
+}
+
+inline Profiler::Scope::~Scope()
+{
+  if (begin_ >= 0) {
+    Profiler& profiler = singleton();
+    profiler.record(name_, begin_, profiler.now());
+  }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "search_trace.h"
+
+#include <algorithm>
+#include <fstream>
+
+using Cell = Grid::Cell;
+using State = Grid::Cell::VisualizationState;
+
+namespace {
+
+/*
+ * File format.
+ *
+ * Values are written in the byte order of the machine, which is little-endian on every
+ * platform the visualizer is built for:
+ *
+ *   char     magic[8]          "SVTRACE"
+ *   uint32   version
+ *   int32    width, height
+ *   uint32   costs[width * height]
+ *   uint8    states[width * height]   The initial state of every cell.
+ *   uint64   stepCount
+ *   uint32   stepEnds[stepCount]
+ *   uint64   transitionCount
+ *   uint32   transitions[transitionCount]
+ *
+ * Keyframes are not saved, since they can be rebuilt from the transitions.
+ */
+
+constexpr char MAGIC[8] = "SVTRACE"; // Identifies a trace file.
+constexpr uint32_t VERSION = 1; // The version of the file format.
+
+/**
+ * Write a value to a stream.
+ *
+ * \param out The stream to write to.
+ * \param value The value to write.
+ */
+template <typename T> void write(std::ofstream& out, const T& value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * Write the contents of a vector to a stream.
+ *
+ * \param out The stream to write to.
+ * \param values The values to write.
+ */
+template <typename T> void writeAll(std::ofstream& out, const std::vector<T>& values)
+{
+  out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+/**
+ * Read a value from a stream.
+ *
+ * \param in The stream to read from.
+ * \param value Set to the value read.
+ * \return True if the value was read.
+ */
+template <typename T> bool read(std::ifstream& in, T& value)
+{
+  return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+/**
+ * Read values from a stream into a vector.
+ * Nothing is allocated unless the stream holds enough data, so a corrupt count can't
+ * exhaust memory.
+ *
+ * \param in The stream to read from.
+ * \param values Resized and filled with the values read.
+ * \param count The number of values to read.
+ * \return True if every value was read.
+ */
+template <typename T>
+bool readAll(std::ifstream& in, std::vector<T>& values, uint64_t count)
+{
+  const std::streampos position = in.tellg();
+  in.seekg(0, std::ios::end);
+  const std::streampos end = in.tellg();
+  in.seekg(position);
+  if (!in || (uint64_t)(end - position) / sizeof(T) < count) {
+    return false;
+  }
+  values.resize(count);
+  return (bool)in.read(reinterpret_cast<char*>(values.data()), count * sizeof(T));
+}
+}
+
+constexpr int SearchTrace::STATE_BITS;
+constexpr size_t SearchTrace::MIN_KEYFRAME_INTERVAL;
+
+SearchTrace::SearchTrace()
+    : width_(0)
+    , height_(0)
+    , keyframeInterval_(MIN_KEYFRAME_INTERVAL)
+{
+  keyframes_.push_back({ 0, current_ });
+}
+
+SearchTrace::SearchTrace(const Grid& grid)
+    : width_(grid.getWidth())
+    , height_(grid.getHeight())
+{
+  const int size = width_ * height_;
+  costs_.resize(size);
+  current_.resize(size);
+  for (int i = 0; i < size; i++) {
+    costs_[i] = grid.grid[i]->cost;
+    current_[i] = (uint8_t)grid.grid[i]->vis;
+  }
+  keyframes_.push_back({ 0, current_ });
+  keyframeInterval_ = std::max(MIN_KEYFRAME_INTERVAL, (size_t)size);
+}
+
+void SearchTrace::append(const SearchAlgorithms::CellEventBuffer& events)
+{
+  auto event = events.begin();
+  size_t count = 0;
+  auto appendStep = [&](size_t end) {
+    for (; count < end; ++count, ++event) {
+      transitions_.push_back(
+          (uint32_t)event->index << STATE_BITS | (uint32_t)event->state);
+      current_[event->index] = (uint8_t)event->state;
+    }
+    endStep();
+  };
+
+  for (size_t end : events.expansionEnds()) {
+    appendStep(end);
+  }
+
+  // Events that weren't part of an expansion make up one more step.
+  if (count < events.size()) {
+    appendStep(events.size());
+  }
+}
+
+void SearchTrace::sync(const Grid& grid)
+{
+  const size_t end = transitions_.size();
+  for (size_t i = 0; i < current_.size(); i++) {
+    const uint8_t state = (uint8_t)grid.grid[i]->vis;
+    if (state != current_[i]) {
+      transitions_.push_back((uint32_t)i << STATE_BITS | state);
+      current_[i] = state;
+    }
+  }
+  if (transitions_.size() != end) {
+    endStep();
+  }
+}
+
+void SearchTrace::seek(size_t step, std::vector<State>& states) const
+{
+  step = std::min(step, steps());
+
+  // Find the last keyframe at or before the step.
+  auto keyframe = std::upper_bound(keyframes_.begin(), keyframes_.end(), step,
+      [](size_t step, const Keyframe& keyframe) { return step < keyframe.step; });
+  --keyframe;
+
+  // Copy the keyframe, then replay the transitions made since it.
+  states.resize(keyframe->states.size());
+  for (size_t i = 0; i < states.size(); i++) {
+    states[i] = (State)keyframe->states[i];
+  }
+  const uint32_t mask = (1 << STATE_BITS) - 1;
+  for (size_t i = stepEnd(keyframe->step); i < stepEnd(step); i++) {
+    states[transitions_[i] >> STATE_BITS] = (State)(transitions_[i] & mask);
+  }
+}
+
+size_t SearchTrace::steps() const { return stepEnds_.size(); }
+
+int SearchTrace::width() const { return width_; }
+
+int SearchTrace::height() const { return height_; }
+
+const std::vector<unsigned int>& SearchTrace::costs() const { return costs_; }
+
+bool SearchTrace::save(const std::string& path) const
+{
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+
+  out.write(MAGIC, sizeof(MAGIC));
+  write(out, VERSION);
+  write(out, (int32_t)width_);
+  write(out, (int32_t)height_);
+  writeAll(out, costs_);
+  writeAll(out, keyframes_.front().states);
+  write(out, (uint64_t)stepEnds_.size());
+  writeAll(out, stepEnds_);
+  write(out, (uint64_t)transitions_.size());
+  writeAll(out, transitions_);
+
+  return (bool)out;
+}
+
+bool SearchTrace::load(const std::string& path)
+{
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+
+  // Check the header.
+  char magic[sizeof(MAGIC)];
+  uint32_t version;
+  int32_t width, height;
+  if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)
+      || !read(in, version) || version != VERSION || !read(in, width)
+      || !read(in, height)) {
+    return false;
+  }
+  if (width <= 0 || height <= 0
+      || (uint64_t)width * height > (uint64_t)1 << (32 - STATE_BITS)) {
+    return false;
+  }
+  const size_t size = (size_t)width * height;
+
+  // Read the grid.
+  SearchTrace trace;
+  std::vector<uint8_t> initial;
+  if (!readAll(in, trace.costs_, size) || !readAll(in, initial, size)) {
+    return false;
+  }
+  for (uint8_t state : initial) {
+    if (state > (uint8_t)State::PATH) {
+      return false;
+    }
+  }
+
+  // Read the steps.
+  uint64_t stepCount, transitionCount;
+  std::vector<uint32_t> stepEnds, transitions;
+  if (!read(in, stepCount) || !readAll(in, stepEnds, stepCount)
+      || !read(in, transitionCount) || transitionCount > UINT32_MAX
+      || !readAll(in, transitions, transitionCount)) {
+    return false;
+  }
+
+  // Replay the steps to check them and to rebuild the keyframes.
+  trace.width_ = width;
+  trace.height_ = height;
+  trace.current_ = initial;
+  trace.keyframes_.front().states = initial;
+  trace.keyframeInterval_ = std::max(MIN_KEYFRAME_INTERVAL, size);
+  trace.transitions_.reserve(transitions.size());
+  trace.stepEnds_.reserve(stepEnds.size());
+  const uint32_t mask = (1 << STATE_BITS) - 1;
+  size_t next = 0;
+  for (uint32_t end : stepEnds) {
+    if (end < next || end > transitions.size()) {
+      return false;
+    }
+    for (; next < end; next++) {
+      const uint32_t index = transitions[next] >> STATE_BITS;
+      const uint32_t state = transitions[next] & mask;
+      if (index >= size || state > (uint32_t)State::PATH) {
+        return false;
+      }
+      trace.transitions_.push_back(transitions[next]);
+      trace.current_[index] = (uint8_t)state;
+    }
+    trace.endStep();
+  }
+  if (next != transitions.size()) {
+    return false;
+  }
+
+  *this = std::move(trace);
+  return true;
+}
+
+/*
+ * Private.
+ */
+
+void SearchTrace::endStep()
+{
+  stepEnds_.push_back(transitions_.size());
+  if (transitions_.size() - stepEnd(keyframes_.back().step) >= keyframeInterval_) {
+    keyframes_.push_back({ steps(), current_ });
+  }
+}
+
+size_t SearchTrace::stepEnd(size_t step) const
+{
+  return step == 0 ? 0 : stepEnds_[step - 1];
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#ifndef SEARCH_TRACE_H
+#define SEARCH_TRACE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "algorithms/cell_events.h"
+#include "grid.h"
+
+/**
+ * A recording of a search, as the visualization states its cells went through.
+ *
+ * The trace is a list of steps, usually one per expansion, each holding the cell state
+ * transitions it made. A transition is packed into 32 bits: the index of the cell and
+ * its new state. Periodic keyframes of the whole grid's states let any step be rebuilt
+ * by copying the last keyframe before it and replaying at most one keyframe interval of
+ * transitions, rather than re-running the search.
+ *
+ * A keyframe is taken once a keyframe interval of transitions has built up since the
+ * last one. The interval is at least the number of cells, so keyframes never take more
+ * memory than the transitions they skip over.
+ *
+ * Only the visualization states are recorded. The costs and initial states of the cells
+ * are kept too, so that a trace can be saved and loaded onto a fresh grid.
+ */
+class SearchTrace {
+  public:
+
+  static constexpr int STATE_BITS
+      = 3; // The number of bits of a transition used for the new state.
+  static constexpr size_t MIN_KEYFRAME_INTERVAL
+      = 4096; // The fewest transitions between keyframes.
+
+  /**
+   * Construct a new, empty Search Trace.
+   */
+  SearchTrace();
+
+  /**
+   * Construct a new Search Trace starting from the current state of a grid.
+   *
+   * \param grid The grid being searched.
+   */
+  explicit SearchTrace(const Grid& grid);
+
+  /**
+   * Append a batch of cell events.
+   * Every expansion marked in the buffer becomes a step, and any events after the last
+   * mark become one more step.
+   *
+   * \param events The cell events to append.
+   */
+  void append(const SearchAlgorithms::CellEventBuffer& events);
+
+  /**
+   * Append a step that brings every cell up to its current state in a grid.
+   * This catches the trace up with changes that were not recorded as events, such as
+   * a stretch of search that was not drawn. Nothing is appended if no cell changed.
+   *
+   * \param grid The grid being searched.
+   */
+  void sync(const Grid& grid);
+
+  /**
+   * Rebuild the visualization states of the cells after a step.
+   *
+   * \param step The number of steps to replay, up to `steps()`.
+   * \param states Set to the state of every cell after the step, indexed
+   *               `y * width + x`.
+   */
+  void seek(size_t step, std::vector<Grid::Cell::VisualizationState>& states) const;
+
+  /**
+   * Get the number of steps in the trace.
+   *
+   * \return The number of steps.
+   */
+  size_t steps() const;
+
+  /**
+   * Get the width of the traced grid.
+   *
+   * \return The width of the grid.
+   */
+  int width() const;
+
+  /**
+   * Get the height of the traced grid.
+   *
+   * \return The height of the grid.
+   */
+  int height() const;
+
+  /**
+   * Get the cost of every cell of the traced grid.
+   *
+   * \return The costs of the cells, indexed `y * width + x`.
+   */
+  const std::vector<unsigned int>& costs() const;
+
+  /**
+   * Save the trace to a file.
+   *
+   * \param path The path of the file.
+   * \return True if the trace was saved.
+   */
+  bool save(const std::string& path) const;
+
+  /**
+   * Replace the trace with one loaded from a file.
+   * The trace is left unchanged if the file can't be read or is not a valid trace.
+   *
+   * \param path The path of the file.
+   * \return True if the trace was loaded.
+   */
+  bool load(const std::string& path);
+
+  private:
+
+  /**
+   * A copy of every cell's state after some step.
+   */
+  struct Keyframe {
+    size_t step; // The number of steps replayed to get to the keyframe.
+    std::vector<uint8_t> states; // The state of every cell.
+  };
+
+  /**
+   * End the current step, taking a keyframe if one is due.
+   */
+  void endStep();
+
+  /**
+   * Get the number of transitions made by the first steps.
+   *
+   * \param step The number of steps.
+   * \return The number of transitions made by those steps.
+   */
+  size_t stepEnd(size_t step) const;
+
+  /*
+   * Data.
+   */
+
+  int width_; // The width of the traced grid.
+  int height_; // The height of the traced grid.
+  std::vector<unsigned int> costs_; // The cost of every cell.
+  std::vector<uint32_t> transitions_; // Packed cell indices and new states.
+  std::vector<uint32_t> stepEnds_; // The number of transitions at each step's end.
+  std::vector<Keyframe> keyframes_; // Keyframes in step order, starting at step 0.
+  std::vector<uint8_t> current_; // The state of every cell after the last step.
+  size_t keyframeInterval_; // The number of transitions between keyframes.
+};
+
+#endif
\ No newline at end of file
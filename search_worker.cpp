@@ -0,0 +1,200 @@
+#include "search_worker.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "profiler.h"
+
+using Status = SearchAlgorithms::SearchAlgorithm::Status;
+
+SearchWorker::SearchWorker(
+    std::shared_ptr<SearchAlgorithms::SearchAlgorithm> searchAlgorithm, int gridWidth,
+    std::shared_ptr<SearchTrace> trace)
+    : searchAlgorithm_(std::move(searchAlgorithm))
+    , queue_(QUEUE_CAPACITY)
+    , gridWidth_(gridWidth)
+    , trace_(std::move(trace))
+    , running_(false)
+    , cancelled_(false)
+    , draw_(true)
+    , speed_(1)
+    , status_(Status::RUNNING)
+    , expansions_(0)
+    , headlessExpansions_(0)
+    , headlessMilliseconds_(0)
+    , thread_(&SearchWorker::loop, this)
+{
+}
+
+SearchWorker::~SearchWorker() { cancel(); }
+
+void SearchWorker::resume()
+{
+  std::lock_guard<std::mutex> lock(controlMutex_);
+  running_ = true;
+  wakeup_.notify_all();
+}
+
+void SearchWorker::pause()
+{
+  std::lock_guard<std::mutex> lock(controlMutex_);
+  running_ = false;
+  wakeup_.notify_all();
+}
+
+void SearchWorker::cancel()
+{
+  {
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    cancelled_ = true;
+    wakeup_.notify_all();
+  }
+  searchAlgorithm_->interrupt();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void SearchWorker::setPace(bool draw, int speed)
+{
+  std::lock_guard<std::mutex> lock(controlMutex_);
+  draw_ = draw;
+  speed_ = speed;
+  wakeup_.notify_all();
+}
+
+void SearchWorker::poll(SearchAlgorithms::CellEventBuffer& events)
+{
+  SearchAlgorithms::CellEvent event;
+  while (queue_.pop(event)) {
+    events.push(event);
+  }
+}
+
+Status SearchWorker::status() const { return status_.load(std::memory_order_acquire); }
+
+unsigned long SearchWorker::expansions() const
+{
+  return expansions_.load(std::memory_order_relaxed);
+}
+
+unsigned long SearchWorker::headlessExpansions() const
+{
+  return headlessExpansions_.load(std::memory_order_relaxed);
+}
+
+double SearchWorker::headlessMilliseconds() const
+{
+  return headlessMilliseconds_.load(std::memory_order_relaxed);
+}
+
+SearchAlgorithms::SearchCounters SearchWorker::counters() const
+{
+  std::lock_guard<std::mutex> lock(countersMutex_);
+  return counters_;
+}
+
+std::mutex& SearchWorker::gridMutex() { return gridMutex_; }
+
+/*
+ * Private.
+ */
+
+void SearchWorker::loop()
+{
+  using Clock = std::chrono::steady_clock;
+  Profiler::singleton().nameThread("Search worker");
+
+  SearchAlgorithms::CellEventBuffer events(gridWidth_);
+  double credit = 1; // The expansions that the chosen rate allows but haven't been run.
+  Clock::time_point paced = Clock::now(); // When the credit was last topped up.
+
+  while (waitUntilRunning()) {
+    const bool draw = draw_;
+    const int speed = speed_;
+    const bool limited = draw && speed != UNLIMITED_SPEED;
+
+    // Top up the credit for the time that has passed. It is capped at two frames'
+    // worth, which absorbs a late wakeup but doesn't let time spent paused or behind
+    // turn into a burst.
+    unsigned long budget = 0;
+    if (limited) {
+      const Clock::time_point now = Clock::now();
+      credit += speed * std::chrono::duration<double>(now - paced).count();
+      credit = std::min(credit, std::max(1.0, speed * 2 * FRAME_MS / 1000.0));
+      paced = now;
+      budget = (unsigned long)credit;
+    }
+
+    // Run as many expansions as the rate allows while drawing, or search for a while
+    // without recording anything.
+    if (!limited || budget > 0) {
+      Status status;
+      events.clear();
+      events.setAnnotate(draw);
+      {
+        PROFILE_SCOPE("SearchWorker::step");
+        std::lock_guard<std::mutex> lock(gridMutex_);
+        const unsigned long before = searchAlgorithm_->expansions();
+        if (draw) {
+          status = searchAlgorithm_->run(budget, FRAME_MS, &events);
+          credit -= searchAlgorithm_->expansions() - before;
+          if (trace_ != nullptr) {
+            trace_->append(events);
+          }
+        } else {
+          auto begin = Clock::now();
+          status = searchAlgorithm_->run(0, HEADLESS_SLICE_MS);
+          auto end = Clock::now();
+          const unsigned long after = searchAlgorithm_->expansions();
+          headlessExpansions_.store(headlessExpansions_ + after - before);
+          headlessMilliseconds_.store(headlessMilliseconds_
+              + std::chrono::duration<double, std::milli>(end - begin).count());
+        }
+        expansions_.store(searchAlgorithm_->expansions(), std::memory_order_relaxed);
+        std::lock_guard<std::mutex> countersLock(countersMutex_);
+        counters_ = searchAlgorithm_->counters();
+      }
+
+      if (!publish(events)) {
+        return;
+      }
+
+      // The events go out before the status, so that the GUI thread sees all of them.
+      if (status != Status::RUNNING) {
+        status_.store(status, std::memory_order_release);
+        return;
+      }
+    }
+
+    // Wait until the next expansion is due, but no less than a frame, so that fast
+    // rates run in batches. Wake early if anything changes.
+    if (limited) {
+      const double seconds = std::max((1 - credit) / speed, FRAME_MS / 1000.0);
+      std::unique_lock<std::mutex> lock(controlMutex_);
+      wakeup_.wait_for(lock, std::chrono::duration<double>(seconds),
+          [&] { return cancelled_ || !running_ || !draw_ || speed_ != speed; });
+    }
+  }
+}
+
+bool SearchWorker::waitUntilRunning()
+{
+  std::unique_lock<std::mutex> lock(controlMutex_);
+  wakeup_.wait(lock, [&] { return cancelled_ || running_; });
+  return !cancelled_;
+}
+
+bool SearchWorker::publish(const SearchAlgorithms::CellEventBuffer& events)
+{
+  PROFILE_SCOPE("SearchWorker::publish");
+  for (const SearchAlgorithms::CellEvent& event : events) {
+    while (!queue_.push(event)) {
+      if (cancelled_) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+  }
+  return true;
+}
\ No newline at end of file
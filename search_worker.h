@@ -0,0 +1,194 @@
+#ifndef SEARCH_WORKER_H
+#define SEARCH_WORKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "algorithms/cell_events.h"
+#include "algorithms/search_algorithm.h"
+#include "algorithms/spsc_queue.h"
+#include "search_trace.h"
+
+/**
+ * Runs a search algorithm on its own thread.
+ *
+ * The worker starts paused. While it runs, every cell event is passed to the GUI thread
+ * through a lock-free queue, which the GUI thread drains with `poll()`. The search
+ * writes to the grid's cells, so the GUI thread must hold `gridMutex()` whenever it
+ * reads them while the worker is alive. The worker only holds it while it is expanding
+ * cells, never while it is waiting.
+ *
+ * Every batch of events that is drawn is also appended to the search's trace, if it has
+ * one. The trace is guarded by `gridMutex()` as well.
+ */
+class SearchWorker {
+  public:
+
+  static constexpr int FRAME_MS = 16; // How often cell events are drawn.
+  static constexpr int UNLIMITED_SPEED = 0; // A speed that doesn't limit the search.
+  static constexpr double HEADLESS_SLICE_MS
+      = 15; // How long to search for between checks when not drawing.
+  static constexpr size_t QUEUE_CAPACITY
+      = 1 << 16; // How many cell events can wait for the GUI thread.
+
+  /**
+   * Construct a new Search Worker and start its thread, paused.
+   *
+   * \param searchAlgorithm The search algorithm to run.
+   * \param gridWidth The width of the grid being searched.
+   * \param trace The trace to record the search in, or nullptr.
+   */
+  SearchWorker(std::shared_ptr<SearchAlgorithms::SearchAlgorithm> searchAlgorithm,
+      int gridWidth, std::shared_ptr<SearchTrace> trace = nullptr);
+
+  /**
+   * Cancel the search and wait for the thread to finish.
+   */
+  ~SearchWorker();
+
+  /**
+   * Don't allow the worker to be copied.
+   */
+  SearchWorker(SearchWorker const&) = delete;
+
+  /**
+   * Don't allow the worker to be assigned.
+   */
+  void operator=(SearchWorker const&) = delete;
+
+  /**
+   * Let the search run.
+   */
+  void resume();
+
+  /**
+   * Pause the search once the current batch of expansions is done.
+   */
+  void pause();
+
+  /**
+   * Stop the search for good and wait for the thread to finish.
+   */
+  void cancel();
+
+  /**
+   * Set how the search is paced.
+   * When drawing, the search expands cells at the given rate. Rates faster than the
+   * frame rate are run in batches of expansions, one batch per frame. At an unlimited
+   * speed, or when not drawing, the search runs flat out. Events are only recorded
+   * while drawing.
+   *
+   * \param draw Whether or not the search is being drawn.
+   * \param speed The number of expansions per second while drawing, or
+   * UNLIMITED_SPEED.
+   */
+  void setPace(bool draw, int speed);
+
+  /**
+   * Move every cell event that the worker has produced into a buffer.
+   * This may only be called from the GUI thread.
+   *
+   * \param events The buffer to append the events to.
+   */
+  void poll(SearchAlgorithms::CellEventBuffer& events);
+
+  /**
+   * Get the state of the search.
+   * Once this is not RUNNING, every event of the search can be polled and the search
+   * algorithm is no longer touched by the worker.
+   *
+   * \return The state of the search.
+   */
+  SearchAlgorithms::SearchAlgorithm::Status status() const;
+
+  /**
+   * Get the number of expansions done so far.
+   *
+   * \return The number of expansions done so far.
+   */
+  unsigned long expansions() const;
+
+  /**
+   * Get the number of expansions done while the search was not being drawn.
+   *
+   * \return The number of expansions done without drawing.
+   */
+  unsigned long headlessExpansions() const;
+
+  /**
+   * Get the time spent searching while the search was not being drawn.
+   *
+   * \return The wall-clock time of the expansions done without drawing (ms).
+   */
+  double headlessMilliseconds() const;
+
+  /**
+   * Get the counts of what the search has done, as of the last batch of expansions.
+   *
+   * \return The counts.
+   */
+  SearchAlgorithms::SearchCounters counters() const;
+
+  /**
+   * Get the mutex that guards the grid's cells while the worker is alive.
+   *
+   * \return The grid mutex.
+   */
+  std::mutex& gridMutex();
+
+  private:
+
+  /**
+   * The body of the worker thread.
+   */
+  void loop();
+
+  /**
+   * Wait until the worker is resumed or cancelled.
+   *
+   * \return False if the worker was cancelled.
+   */
+  bool waitUntilRunning();
+
+  /**
+   * Pass events to the GUI thread, waiting for room in the queue if necessary.
+   *
+   * \param events The events to pass on.
+   * \return False if the worker was cancelled while waiting.
+   */
+  bool publish(const SearchAlgorithms::CellEventBuffer& events);
+
+  /*
+   * Data.
+   */
+
+  std::shared_ptr<SearchAlgorithms::SearchAlgorithm>
+      searchAlgorithm_; // The search algorithm to run.
+  SearchAlgorithms::SpscQueue<SearchAlgorithms::CellEvent>
+      queue_; // Cell events on their way to the GUI thread.
+  int gridWidth_; // The width of the grid being searched.
+  std::shared_ptr<SearchTrace> trace_; // The trace to record the search in.
+
+  std::mutex gridMutex_; // Guards the grid's cells.
+  std::mutex controlMutex_; // Guards waiting on `wakeup_`.
+  std::condition_variable wakeup_; // Signalled when the worker is resumed or cancelled.
+  std::atomic<bool> running_; // Whether the search may run.
+  std::atomic<bool> cancelled_; // Whether the search has been cancelled.
+  std::atomic<bool> draw_; // Whether the search is being drawn.
+  std::atomic<int> speed_; // The number of expansions per second while drawing.
+  std::atomic<SearchAlgorithms::SearchAlgorithm::Status>
+      status_; // The state of the search.
+  std::atomic<unsigned long> expansions_; // The number of expansions done so far.
+  std::atomic<unsigned long>
+      headlessExpansions_; // The number of expansions done without drawing.
+  std::atomic<double> headlessMilliseconds_; // The time searched without drawing.
+  SearchAlgorithms::SearchCounters counters_; // The counts after the last batch.
+  mutable std::mutex countersMutex_; // Guards `counters_`.
+
+  std::thread thread_; // The worker thread.
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,579 @@
+/*
+ * A batch solver that runs many queries over one map without the visualizer.
+ *
+ * The map is read from a saved trace, a grid snapshot or a Moving AI `.map` file, or
+ * generated from a seed. The queries are read from a Moving AI `.scen` file or a plain
+ * scenario file with one query per line: the x and y coordinates of its start cell,
+ * then those of its goal cell, separated by whitespace. Blank lines and lines starting
+ * with '#' are skipped. A Moving AI scenario's own map is used if no map is given.
+ * Without a scenario file, the map's own start and goal cells make the only query.
+ *
+ * Every query is solved by every chosen engine. The engines keep their search state in
+ * the cells, so each thread searches its own copy of the map, made once and reused
+ * for all of its queries; `findpath` runs `findPath()`, which never writes to the
+ * grid, on the loaded map itself. The results are collected by query and engine and
+ * only written once every query is solved, so the CSV is in the same order however the
+ * threads were scheduled. Apart from the time column, which `--no-time` leaves out,
+ * two runs give identical output.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../algorithms/engine_table.h"
+#include "../algorithms/find_path.h"
+#include "../grid.h"
+#include "../grid_snapshot.h"
+#include "../map_generator.h"
+#include "../moving_ai.h"
+#include "../search_trace.h"
+
+using namespace SearchAlgorithms;
+using Cell = Grid::Cell;
+using State = Grid::Cell::VisualizationState;
+using Status = SearchAlgorithm::Status;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+const std::string FIND_PATH = "findpath"; // The engine that runs `findPath()`.
+
+/**
+ * The options of a batch.
+ */
+struct Options {
+  std::string map; // The map to search, if not the scenario's.
+  bool generate = false; // Whether to search a generated map.
+  MapGenerator::Settings generator; // What to generate.
+  std::string scenarios; // The file to load the queries from, if any.
+  std::vector<std::string> engines = { "astar" }; // The engines to run.
+  int threads = 0; // The number of threads to solve on (0 for one per core).
+  unsigned long maxExpansions = 0; // The most expansions per query (0 for no limit).
+  std::string out = "-"; // The file to write the CSV to ('-' for stdout).
+  bool time = true; // Whether to write the time taken by each query.
+};
+
+/**
+ * A query to solve.
+ */
+struct Query {
+  int start; // The index of the start cell.
+  int goal; // The index of the goal cell.
+};
+
+/**
+ * The outcome of one query solved by one engine.
+ */
+struct Result {
+  std::string status; // How the search ended, or why it was skipped.
+  double cost = 0; // The cost of the path found.
+  unsigned long expansions = 0; // The number of expansions of the search.
+  double milliseconds = 0; // The time the search took.
+};
+
+/**
+ * Silences `std::cout` while it is alive, since the engines report their results there.
+ */
+class QuietOutput {
+  public:
+
+  QuietOutput()
+      : saved_(std::cout.rdbuf(nullptr))
+  {
+  }
+
+  ~QuietOutput()
+  {
+    std::cout.rdbuf(saved_);
+    std::cout.clear();
+  }
+
+  private:
+
+  std::streambuf* saved_; // The buffer that `std::cout` wrote to.
+};
+
+/**
+ * Print the usage of the batch solver.
+ *
+ * \param name The name the batch solver was run as.
+ */
+void usage(const char* name)
+{
+  std::cerr
+      << "Usage: " << name << " [--map FILE | --layout L] [--scen FILE] [options]\n"
+      << "  --map FILE          Search the map of a saved trace, a .grid snapshot or\n"
+      << "                      a Moving AI .map.\n"
+      << "  --layout L          Search a generated map: obstacles, maze, noise, rooms\n"
+      << "                      or city.\n"
+      << "  --width N           Width of a generated map (default 256).\n"
+      << "  --height N          Height of a generated map (default 256).\n"
+      << "  --density P         Density of a generated map (default 0.2).\n"
+      << "  --seed N            Seed of a generated map (default 1).\n"
+      << "  --scen FILE         Queries from a Moving AI .scen, or one\n"
+      << "                      'startX startY goalX goalY' per line (default the\n"
+      << "                      map's start and goal).\n"
+      << "  --engines LIST      Comma-separated engines: astar, dijkstra, bitbfs,\n"
+      << "                      fringe, hda, subgoal, theta, lazy-theta or findpath\n"
+      << "                      (A* without touching the grid; default astar).\n"
+      << "  --threads N         Threads to solve on (default one per core).\n"
+      << "  --max-expansions N  Give up on a query after N expansions (default no "
+         "limit).\n"
+      << "  --out FILE          Write the CSV to a file instead of stdout.\n"
+      << "  --no-time           Leave out the time column, for diffable output.\n";
+}
+
+/**
+ * Parse the command line.
+ *
+ * \param argc The number of arguments.
+ * \param argv The arguments.
+ * \param options Set to the options given.
+ * \return False if the command line is invalid.
+ */
+bool parse(int argc, char* argv[], Options& options)
+{
+  for (int i = 1; i < argc; i++) {
+    const std::string option = argv[i];
+    if (option == "--no-time") {
+      options.time = false;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const std::string value = argv[++i];
+
+    char* end = nullptr;
+    MapGenerator::Settings& generator = options.generator;
+    if (option == "--map") {
+      options.map = value;
+    } else if (option == "--layout") {
+      options.generate = true;
+      if (!MapGenerator::layoutNamed(value, generator.layout)) {
+        return false;
+      }
+    } else if (option == "--width") {
+      generator.width = (int)std::strtol(value.c_str(), &end, 10);
+    } else if (option == "--height") {
+      generator.height = (int)std::strtol(value.c_str(), &end, 10);
+    } else if (option == "--density") {
+      generator.density = std::strtod(value.c_str(), &end);
+    } else if (option == "--seed") {
+      generator.seed = (unsigned int)std::strtoul(value.c_str(), &end, 10);
+    } else if (option == "--scen") {
+      options.scenarios = value;
+    } else if (option == "--engines") {
+      std::stringstream list(value);
+      std::string engine;
+      options.engines.clear();
+      while (std::getline(list, engine, ',')) {
+        options.engines.push_back(engine);
+      }
+    } else if (option == "--threads") {
+      options.threads = (int)std::strtol(value.c_str(), &end, 10);
+    } else if (option == "--max-expansions") {
+      options.maxExpansions = std::strtoul(value.c_str(), &end, 10);
+    } else if (option == "--out") {
+      options.out = value;
+    } else {
+      return false;
+    }
+
+    // A number must make up the whole value.
+    if (end != nullptr && *end != '\0') {
+      return false;
+    }
+  }
+
+  const MapGenerator::Settings& generator = options.generator;
+  return (!options.map.empty() || !options.scenarios.empty() || options.generate)
+      && !options.engines.empty() && options.threads >= 0 && generator.width > 0
+      && generator.height > 0 && generator.density >= 0 && generator.density <= 1;
+}
+
+/**
+ * Read queries from a scenario file.
+ *
+ * \param path The path of the scenario file.
+ * \param grid The grid that the queries are on.
+ * \param queries Set to the queries.
+ * \return False if the file can't be read or has a bad line, which is reported.
+ */
+bool readScenarios(
+    const std::string& path, const Grid& grid, std::vector<Query>& queries)
+{
+  std::ifstream in(path);
+  if (!in) {
+    std::cerr << "Could not read " << path << "\n";
+    return false;
+  }
+
+  std::string line;
+  for (int number = 1; std::getline(in, line); number++) {
+    std::istringstream fields(line);
+    std::string first;
+    if (!(fields >> first) || first[0] == '#') {
+      continue;
+    }
+    fields.str(line);
+    fields.clear();
+
+    int startX, startY, goalX, goalY;
+    std::string extra;
+    if (!(fields >> startX >> startY >> goalX >> goalY) || fields >> extra) {
+      std::cerr << path << ":" << number << ": expected 'startX startY goalX goalY'\n";
+      return false;
+    }
+    for (int coordinate : { startX, goalX }) {
+      if (coordinate < 0 || coordinate >= grid.getWidth()) {
+        std::cerr << path << ":" << number << ": x is outside the map\n";
+        return false;
+      }
+    }
+    for (int coordinate : { startY, goalY }) {
+      if (coordinate < 0 || coordinate >= grid.getHeight()) {
+        std::cerr << path << ":" << number << ": y is outside the map\n";
+        return false;
+      }
+    }
+    queries.push_back({ startY * grid.getWidth() + startX,
+        goalY * grid.getWidth() + goalX });
+  }
+  return true;
+}
+
+/**
+ * Load the map of a saved trace.
+ *
+ * \param path The path of the trace file.
+ * \param grid Set to the map.
+ * \param queries Set to the trace's start and goal, if it has both.
+ * \return False if the trace can't be loaded.
+ */
+bool loadTrace(
+    const std::string& path, std::shared_ptr<Grid>& grid, std::vector<Query>& queries)
+{
+  SearchTrace trace;
+  if (!trace.load(path)) {
+    return false;
+  }
+  grid = std::make_shared<Grid>(trace.width(), trace.height());
+  for (int y = 0; y < trace.height(); y++) {
+    grid->setRowCosts(y,
+        std::vector<unsigned int>(trace.costs().begin() + y * trace.width(),
+            trace.costs().begin() + (y + 1) * trace.width()));
+  }
+
+  std::vector<State> states;
+  trace.seek(0, states);
+  auto start = std::find(states.begin(), states.end(), State::START);
+  auto goal = std::find(states.begin(), states.end(), State::GOAL);
+  if (start != states.end() && goal != states.end()) {
+    queries.push_back({ (int)(start - states.begin()), (int)(goal - states.begin()) });
+  }
+  return true;
+}
+
+/**
+ * Load the map of a grid snapshot.
+ *
+ * \param path The path of the snapshot file.
+ * \param grid Set to the map.
+ * \param queries Set to the snapshot's start and goal, if it has both.
+ * \return False if the snapshot can't be loaded.
+ */
+bool loadSnapshot(
+    const std::string& path, std::shared_ptr<Grid>& grid, std::vector<Query>& queries)
+{
+  GridSnapshot snapshot;
+  if (!snapshot.open(path)) {
+    return false;
+  }
+  grid = snapshot.grid();
+  if (snapshot.start() != -1 && snapshot.goal() != -1) {
+    queries.push_back({ snapshot.start(), snapshot.goal() });
+  }
+  return true;
+}
+
+/**
+ * Get the name of the status a search finished with.
+ *
+ * \param status The status.
+ * \return The name of the status.
+ */
+const char* statusName(Status status)
+{
+  switch (status) {
+  case Status::FOUND:
+    return "found";
+  case Status::NO_PATH:
+    return "no path";
+  case Status::RUNNING:
+    return "gave up";
+  }
+  return "";
+}
+
+/**
+ * Get an engine by its name on the command line.
+ *
+ * \param table The engines that search a copy of the map.
+ * \param name The name of the engine.
+ * \param engine Set to the engine, whose factory is empty for `findpath`.
+ * \return False if there is no engine with that name.
+ */
+bool engineNamed(
+    const std::vector<NamedEngine>& table, const std::string& name, NamedEngine& engine)
+{
+  if (name == FIND_PATH) {
+    engine = { name, nullptr };
+    return true;
+  }
+  for (const NamedEngine& candidate : table) {
+    if (candidate.name == name) {
+      engine = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Copy a map for one thread to search, the way the visualizer would show it.
+ *
+ * \param grid The map.
+ * \param labels The connected components of the map, from `componentLabels()`.
+ * \return The copy.
+ */
+std::shared_ptr<Grid> copyGrid(const Grid& grid, const std::vector<int>& labels)
+{
+  const int width = grid.getWidth();
+  std::shared_ptr<Grid> copy = std::make_shared<Grid>(width, grid.getHeight());
+  std::vector<unsigned int> row(width);
+  for (int y = 0; y < grid.getHeight(); y++) {
+    for (int x = 0; x < width; x++) {
+      const std::shared_ptr<Cell>& cell = copy->grid[y * width + x];
+      row[x] = grid.grid[y * width + x]->cost;
+      if (row[x] == Cell::WALL_COST) {
+        cell->vis = State::WALL;
+      }
+    }
+    copy->setRowCosts(y, row);
+  }
+  copy->setComponentLabels(labels.data());
+  return copy;
+}
+
+/**
+ * Solve a query with an engine.
+ *
+ * \param engine The engine to solve it with.
+ * \param grid The map, which `findpath` searches.
+ * \param copy This thread's copy of the map, which the other engines search.
+ * \param query The query.
+ * \param maxExpansions The most expansions to do (0 for no limit).
+ * \return The outcome.
+ */
+Result solve(const NamedEngine& engine, const Grid& grid,
+    const std::shared_ptr<Grid>& copy, const Query& query, unsigned long maxExpansions)
+{
+  Result result;
+  if (engine.create == nullptr) {
+    FindPathOptions options;
+    options.maxExpansions = maxExpansions;
+    const Clock::time_point begin = Clock::now();
+    const FindPathResult found
+        = findPath(grid, grid.grid[query.start], grid.grid[query.goal], options);
+    result.milliseconds
+        = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    result.status = statusName(found.status);
+    result.cost = found.cost;
+    result.expansions = found.counters.expansions;
+    return result;
+  }
+
+  const std::shared_ptr<SearchAlgorithm> search = engine.create(
+      copy, copy->grid[query.start], copy->grid[query.goal], false);
+  if (search == nullptr) {
+    result.status = "not applicable";
+    return result;
+  }
+  const Clock::time_point begin = Clock::now();
+  const Status status = maxExpansions == 0 ? search->runToCompletion()
+                                           : search->run(maxExpansions);
+  result.milliseconds
+      = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+  result.status = statusName(status);
+  result.cost = pathCost(search->path());
+  result.expansions = search->counters().expansions;
+  return result;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!parse(argc, argv, options)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  // Pick the engines.
+  const std::vector<NamedEngine> table = engineTable();
+  std::vector<NamedEngine> engines;
+  for (const std::string& name : options.engines) {
+    NamedEngine engine;
+    if (!engineNamed(table, name, engine)) {
+      std::cerr << "Unknown engine: " << name << "\n";
+      return 1;
+    }
+    engines.push_back(engine);
+  }
+
+  // A Moving AI scenario names its map, which is searched unless another is given.
+  std::vector<MovingAI::Scenario> scenarios;
+  const bool movingAi = MovingAI::isScenarioPath(options.scenarios);
+  if (movingAi) {
+    if (!MovingAI::loadScenarios(options.scenarios, scenarios)) {
+      std::cerr << "Could not read a Moving AI scenario from " << options.scenarios
+                << "\n";
+      return 1;
+    }
+    if (options.map.empty() && !scenarios.empty()) {
+      options.map = MovingAI::mapPath(options.scenarios, scenarios[0]);
+    }
+  }
+  if (options.map.empty() && !options.generate) {
+    std::cerr << "Could not find the map of " << options.scenarios << "\n";
+    return 1;
+  }
+
+  // Load or generate the map.
+  std::shared_ptr<Grid> grid;
+  std::vector<Query> queries;
+  bool loaded = true;
+  if (options.generate) {
+    options.generator.threads = options.threads;
+    const MapGenerator::Map generated = MapGenerator::generate(options.generator);
+    grid = generated.grid;
+    std::cerr << "Generated " << MapGenerator::describe(options.generator) << "\n";
+    if (generated.start == -1) {
+      std::cerr << "The generated map has no two connected passable cells\n";
+      return 1;
+    }
+    queries.push_back({ generated.start, generated.goal });
+  } else if (MovingAI::isMapPath(options.map)) {
+    loaded = MovingAI::loadMap(options.map, grid);
+  } else if (GridSnapshot::isSnapshotPath(options.map)) {
+    loaded = loadSnapshot(options.map, grid, queries);
+  } else {
+    loaded = loadTrace(options.map, grid, queries);
+  }
+  if (!loaded) {
+    std::cerr << "Could not load a map from " << options.map << "\n";
+    return 1;
+  }
+
+  // Get the queries.
+  if (movingAi) {
+    queries.clear();
+    for (const MovingAI::Scenario& scenario : scenarios) {
+      if (scenario.mapWidth != grid->getWidth()
+          || scenario.mapHeight != grid->getHeight()) {
+        std::cerr << options.scenarios << " has a query on a map of another size\n";
+        return 1;
+      }
+      queries.push_back({ scenario.startY * scenario.mapWidth + scenario.startX,
+          scenario.goalY * scenario.mapWidth + scenario.goalX });
+    }
+  } else if (!options.scenarios.empty()) {
+    queries.clear();
+    if (!readScenarios(options.scenarios, *grid, queries)) {
+      return 1;
+    }
+  } else if (queries.empty()) {
+    std::cerr << options.map << " has no start and goal, so a scenario is needed\n";
+    return 1;
+  }
+
+  /*
+   * Every query is solved by every engine. Each thread takes the next unsolved job and
+   * writes its result into the job's own slot, so no two threads touch the same result
+   * and the results come out in job order. The components are labeled once here, so
+   * that the copies don't each relabel them.
+   */
+
+  const size_t jobs = queries.size() * engines.size();
+  const std::vector<int> labels = grid->componentLabels();
+  std::vector<Result> results(jobs);
+  std::atomic<size_t> next(0);
+  auto work = [&] {
+    std::shared_ptr<Grid> copy;
+    for (size_t job = next++; job < jobs; job = next++) {
+      const NamedEngine& engine = engines[job % engines.size()];
+      if (engine.create != nullptr && copy == nullptr) {
+        copy = copyGrid(*grid, labels);
+      }
+      results[job] = solve(
+          engine, *grid, copy, queries[job / engines.size()], options.maxExpansions);
+    }
+  };
+
+  int threads = options.threads;
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  {
+    QuietOutput quiet;
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads && (size_t)i < jobs; i++) {
+      workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+  // Write the results.
+  std::ofstream file;
+  if (options.out != "-") {
+    file.open(options.out);
+  }
+  std::ostream& out = options.out == "-" ? std::cout : file;
+  out << "query,engine,start_x,start_y,goal_x,goal_y,status,cost,expansions"
+      << (options.time ? ",ms" : "") << "\n";
+  out << std::fixed << std::setprecision(3);
+  const int width = grid->getWidth();
+  for (size_t job = 0; job < jobs; job++) {
+    const Query& query = queries[job / engines.size()];
+    const Result& result = results[job];
+    out << job / engines.size() << "," << options.engines[job % engines.size()] << ","
+        << query.start % width << "," << query.start / width << ","
+        << query.goal % width << "," << query.goal / width << ","
+        << result.status << "," << (unsigned long)result.cost << ","
+        << result.expansions;
+    if (options.time) {
+      out << "," << result.milliseconds;
+    }
+    out << "\n";
+  }
+  out.flush();
+  if (!out) {
+    std::cerr << "Could not write " << options.out << "\n";
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
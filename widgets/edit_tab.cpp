@@ -4,6 +4,11 @@
 #include "../grid.h"
 #include "graphics_area.h"
 
+#include <QFileDialog>
+#include <QFormLayout>
+#include <climits>
+#include <random>
+
 EditTab::EditTab(QWidget* parent)
     : QWidget(parent)
 {
@@ -79,9 +84,83 @@ EditTab::EditTab(QWidget* parent)
   connect(
       resetGridButton, &QPushButton::clicked, this, &EditTab::resetGridButtonClicked);
 
+  // Create the files section.
+  auto filesGroupBox = new QGroupBox("Files", this);
+  auto filesLayout = new QVBoxLayout(filesGroupBox);
+  loadMapButton = new QPushButton("Load Map", filesGroupBox);
+  filesLayout->addWidget(loadMapButton);
+  auto snapshotLayout = new QHBoxLayout;
+  saveSnapshotButton = new QPushButton("Save Snapshot", filesGroupBox);
+  loadSnapshotButton = new QPushButton("Load Snapshot", filesGroupBox);
+  snapshotLayout->addWidget(saveSnapshotButton);
+  snapshotLayout->addWidget(loadSnapshotButton);
+  filesLayout->addLayout(snapshotLayout);
+  editLayout->addWidget(filesGroupBox);
+  connect(loadMapButton, &QPushButton::clicked, this, &EditTab::loadMapButtonClicked);
+  connect(saveSnapshotButton, &QPushButton::clicked, this,
+      &EditTab::saveSnapshotButtonClicked);
+  connect(loadSnapshotButton, &QPushButton::clicked, this,
+      &EditTab::loadSnapshotButtonClicked);
+
+  // Create the generate section.
+  auto generateGroupBox = new QGroupBox("Generate", this);
+  auto generateLayout = new QFormLayout(generateGroupBox);
+  generateLayoutComboBox = new QComboBox(generateGroupBox);
+  for (MapGenerator::Layout layout :
+      { MapGenerator::Layout::OBSTACLES, MapGenerator::Layout::MAZE,
+          MapGenerator::Layout::NOISE, MapGenerator::Layout::ROOMS,
+          MapGenerator::Layout::CITY }) {
+    generateLayoutComboBox->addItem(MapGenerator::layoutName(layout));
+  }
+  generateLayout->addRow("Layout:", generateLayoutComboBox);
+  auto generateSizeLayout = new QHBoxLayout;
+  generateWidthSpinBox = new QSpinBox(generateGroupBox);
+  generateWidthSpinBox->setRange(2, 1024);
+  generateWidthSpinBox->setValue(64);
+  generateHeightSpinBox = new QSpinBox(generateGroupBox);
+  generateHeightSpinBox->setRange(2, 1024);
+  generateHeightSpinBox->setValue(64);
+  generateSizeLayout->addWidget(generateWidthSpinBox);
+  generateSizeLayout->addWidget(new QLabel("x", generateGroupBox));
+  generateSizeLayout->addWidget(generateHeightSpinBox);
+  generateSizeLayout->addStretch();
+  generateLayout->addRow("Size:", generateSizeLayout);
+  generateDensitySpinBox = new QDoubleSpinBox(generateGroupBox);
+  generateDensitySpinBox->setRange(0, 1);
+  generateDensitySpinBox->setSingleStep(0.05);
+  generateDensitySpinBox->setValue(0.2);
+  generateLayout->addRow("Density:", generateDensitySpinBox);
+  generateMaxCostSpinBox = new QSpinBox(generateGroupBox);
+  generateMaxCostSpinBox->setRange(
+      GlobalState::MIN_CELL_COST, GlobalState::MAX_CELL_COST);
+  generateLayout->addRow("Max cost:", generateMaxCostSpinBox);
+  auto generateSeedLayout = new QHBoxLayout;
+  generateSeedSpinBox = new QSpinBox(generateGroupBox);
+  generateSeedSpinBox->setRange(0, INT_MAX);
+  generateSeedSpinBox->setValue(1);
+  newSeedButton = new QPushButton("New Seed", generateGroupBox);
+  generateSeedLayout->addWidget(generateSeedSpinBox);
+  generateSeedLayout->addWidget(newSeedButton);
+  generateLayout->addRow("Seed:", generateSeedLayout);
+  generateButton = new QPushButton("Generate", generateGroupBox);
+  generateLayout->addRow(generateButton);
+  editLayout->addWidget(generateGroupBox);
+  connect(newSeedButton, &QPushButton::clicked, this, &EditTab::newSeedButtonClicked);
+  connect(generateButton, &QPushButton::clicked, this, &EditTab::generateButtonClicked);
+
+  // Create the display section.
+  // This stays visible while a simulation is running.
+  auto displayGroupBox = new QGroupBox("Display", this);
+  auto displayLayout = new QVBoxLayout(displayGroupBox);
+  showPrunedCheckBox = new QCheckBox("Show pruned regions", displayGroupBox);
+  connect(showPrunedCheckBox, &QCheckBox::stateChanged, this,
+      &EditTab::showPrunedClicked);
+  displayLayout->addWidget(showPrunedCheckBox);
+
   // Set the layout.
   layout->addWidget(noEditLabel);
   layout->addWidget(editWidget);
+  layout->addWidget(displayGroupBox);
   layout->addStretch();
   setLayout(layout);
 
@@ -128,4 +207,58 @@ void EditTab::setGoalButtonClicked() { emit setGoalCellSelected(); }
 void EditTab::resetGridButtonClicked()
 {
   emit resetGrid(resetGridWidthSpinBox->value(), resetGridHeightSpinBox->value());
+}
+
+void EditTab::loadMapButtonClicked()
+{
+  QString path = QFileDialog::getOpenFileName(this, "Load Map", QString(),
+      "Moving AI maps and scenarios (*.map *.scen)");
+  if (!path.isEmpty()) {
+    emit loadMap(path);
+  }
+}
+
+void EditTab::saveSnapshotButtonClicked()
+{
+  QString path = QFileDialog::getSaveFileName(
+      this, "Save Snapshot", QString(), "Grid snapshots (*.grid)");
+  if (!path.isEmpty()) {
+    if (!path.endsWith(".grid")) {
+      path += ".grid";
+    }
+    emit saveSnapshot(path);
+  }
+}
+
+void EditTab::loadSnapshotButtonClicked()
+{
+  QString path = QFileDialog::getOpenFileName(
+      this, "Load Snapshot", QString(), "Grid snapshots (*.grid)");
+  if (!path.isEmpty()) {
+    emit loadSnapshot(path);
+  }
+}
+
+void EditTab::newSeedButtonClicked()
+{
+  std::random_device random;
+  generateSeedSpinBox->setValue((int)(random() % ((unsigned int)INT_MAX + 1)));
+}
+
+void EditTab::generateButtonClicked()
+{
+  // The seed stays in its spin box, so the map can be generated again.
+  MapGenerator::Settings settings;
+  settings.layout = (MapGenerator::Layout)generateLayoutComboBox->currentIndex();
+  settings.width = generateWidthSpinBox->value();
+  settings.height = generateHeightSpinBox->value();
+  settings.density = generateDensitySpinBox->value();
+  settings.maxCost = generateMaxCostSpinBox->value();
+  settings.seed = generateSeedSpinBox->value();
+  emit generateMap(settings);
+}
+
+void EditTab::showPrunedClicked(int state)
+{
+  emit showPrunedRegions(state == Qt::Checked);
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef EDIT_TAB_H
 #define EDIT_TAB_H
 
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDoubleSpinBox>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QLabel>
@@ -10,6 +13,7 @@
 #include <QWidget>
 
 #include "../global_state.h"
+#include "../map_generator.h"
 
 class EditTab : public QWidget {
   Q_OBJECT
@@ -41,6 +45,38 @@ class EditTab : public QWidget {
    */
   void resetGridButtonClicked();
 
+  /**
+   * "Load map" button clicked.
+   */
+  void loadMapButtonClicked();
+
+  /**
+   * "Save snapshot" button clicked.
+   */
+  void saveSnapshotButtonClicked();
+
+  /**
+   * "Load snapshot" button clicked.
+   */
+  void loadSnapshotButtonClicked();
+
+  /**
+   * "New seed" button clicked.
+   */
+  void newSeedButtonClicked();
+
+  /**
+   * "Generate" button clicked.
+   */
+  void generateButtonClicked();
+
+  /**
+   * "Show pruned regions" check box clicked.
+   *
+   * \param state Checkbox state.
+   */
+  void showPrunedClicked(int state);
+
   /**
    * Update widget visibility based on simulation type.
    * If there is no current simulation, edit controls will be show.
@@ -88,6 +124,41 @@ class EditTab : public QWidget {
    */
   void resetGrid(int width, int height);
 
+  /**
+   * Signal that a Moving AI map or scenario should be loaded.
+   *
+   * \param path The path of the `.map` or `.scen` file.
+   */
+  void loadMap(const QString& path);
+
+  /**
+   * Signal that the grid should be saved as a snapshot.
+   *
+   * \param path The path of the `.grid` file.
+   */
+  void saveSnapshot(const QString& path);
+
+  /**
+   * Signal that a grid snapshot should be loaded.
+   *
+   * \param path The path of the `.grid` file.
+   */
+  void loadSnapshot(const QString& path);
+
+  /**
+   * Signal that a map should be generated in place of the grid.
+   *
+   * \param settings What to generate.
+   */
+  void generateMap(const MapGenerator::Settings& settings);
+
+  /**
+   * Signal that the pruned regions overlay should be shown or hidden.
+   *
+   * \param show True to show the overlay.
+   */
+  void showPrunedRegions(bool show);
+
   private:
 
   /*
@@ -116,6 +187,33 @@ class EditTab : public QWidget {
 
   // Reset grid button.
   QPushButton* resetGridButton; // The button for resetting the grid.
+
+  /*
+   * Widgets for files section.
+   */
+
+  QPushButton* loadMapButton; // The button for loading a Moving AI map or scenario.
+  QPushButton* saveSnapshotButton; // The button for saving a grid snapshot.
+  QPushButton* loadSnapshotButton; // The button for loading a grid snapshot.
+
+  /*
+   * Widgets for generate section.
+   */
+
+  QComboBox* generateLayoutComboBox; // The layout of the map to generate.
+  QSpinBox* generateWidthSpinBox; // The spin box for the width of the map.
+  QSpinBox* generateHeightSpinBox; // The spin box for the height of the map.
+  QDoubleSpinBox* generateDensitySpinBox; // The spin box for the density of the map.
+  QSpinBox* generateMaxCostSpinBox; // The spin box for the most a cell can cost.
+  QSpinBox* generateSeedSpinBox; // The spin box for the seed of the map.
+  QPushButton* newSeedButton; // The button for picking a new seed at random.
+  QPushButton* generateButton; // The button for generating the map.
+
+  /*
+   * Widgets for display section.
+   */
+
+  QCheckBox* showPrunedCheckBox; // Whether to show the pruned regions.
 };
 
 #endif // EDIT_TAB_H
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include "fringe_tab.h"
+
+FringeTab::FringeTab(QWidget* parent)
+    : QWidget(parent)
+{
+  // Create the simulation parameters.
+  simParams = new SimParams(GlobalState::SimType::FRINGE, this);
+
+  // Create the layout.
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(simParams);
+  layout->addStretch();
+  setLayout(layout);
+}
+
+FringeTab::~FringeTab() { }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef FRINGE_TAB_H
+#define FRINGE_TAB_H
+
+#include <QWidget>
+
+#include "sim_params.h"
+
+class FringeTab : public QWidget {
+  Q_OBJECT
+
+  public:
+  /**
+   * Construct a new Fringe Tab.
+   *
+   * \param parent The parent widget.
+   */
+  FringeTab(QWidget* parent = nullptr);
+
+  /**
+   * Destroy a Fringe Tab.
+   */
+  ~FringeTab();
+
+  private:
+
+  /*
+   * Widgets.
+   */
+
+  SimParams* simParams; // The simulation parameters.
+};
+
+#endif // FRINGE_TAB_H
\ No newline at end of file
@@ -1,13 +1,25 @@
 #include "graphics_area.h"
 #include "../algorithms/astar.h"
+#include "../algorithms/bit_bfs.h"
+#include "../algorithms/dead_end_pruning.h"
 #include "../algorithms/dijkstra.h"
+#include "../algorithms/fringe_search.h"
+#include "../algorithms/hda_star.h"
+#include "../algorithms/subgoal_search.h"
+#include "../algorithms/theta_star.h"
 #include "../game_loop.h"
 #include "../global_state.h"
+#include "../grid_snapshot.h"
+#include "../moving_ai.h"
+#include "../profiler.h"
+#include "../search_trace.h"
 #include "edit_tab.h"
 
 #include <QApplication>
 #include <QGraphicsColorizeEffect>
 #include <QHBoxLayout>
+#include <QInputDialog>
+#include <QMessageBox>
 #include <iostream>
 
 using Cell = Grid::Cell;
@@ -26,6 +38,8 @@ GraphicsArea::GraphicsArea(int minWidth, int minHeight, QWidget* parent)
   GlobalState& globalState = GlobalState::singleton();
   GameLoop& gameLoop = GameLoop::singleton();
   connect(&globalState, &GlobalState::simTypeChanged, this, &GraphicsArea::simTypeSlot);
+  connect(
+      &globalState, &GlobalState::simStateChanged, this, &GraphicsArea::simStateSlot);
   connect(&gameLoop, &GameLoop::updateGraphics, this, &GraphicsArea::updateCells);
 }
 
@@ -35,13 +49,27 @@ GraphicsArea::~GraphicsArea() { }
  * Public slots.
  */
 
-void GraphicsArea::updateCells(std::vector<std::shared_ptr<Grid::Cell>> cells)
+void GraphicsArea::updateCells(const SearchAlgorithms::CellEventBuffer& events)
 {
-  // Update the cells.
-  for (auto& cell : cells) {
-    updateCellGraphics(
-        cell.get(), &cellGraphicsItems[cell->y * grid->getWidth() + cell->x]);
+  PROFILE_SCOPE("GraphicsArea::updateCells");
+
+  // Mark the cells as dirty. A cell can be reported many times in one frame (opened,
+  // improved, closed), but it only needs to be repainted in its final state.
+  for (const SearchAlgorithms::CellEvent& event : events) {
+    if (!dirtyCells[event.index]) {
+      dirtyCells[event.index] = true;
+      dirtyIndices.push_back(event.index);
+    }
+  }
+  cellUpdates += events.size();
+  cellRepaints += dirtyIndices.size();
+
+  // Repaint each dirty cell once.
+  for (int index : dirtyIndices) {
+    updateCellGraphics(grid->grid[index].get(), &cellGraphicsItems[index]);
+    dirtyCells[index] = false;
   }
+  dirtyIndices.clear();
 }
 
 void GraphicsArea::updateInteractionMode(bool editMode) { this->editMode = editMode; }
@@ -58,7 +86,7 @@ void GraphicsArea::setCostSelectedCells(int cost)
     }
 
     // Update the cell cost.
-    cell->cost = cost;
+    grid->setCost(cell, cost);
 
     // Update the visualization state.
     if (cost == Cell::WALL_COST) {
@@ -71,6 +99,10 @@ void GraphicsArea::setCostSelectedCells(int cost)
     updateCellGraphics(
         cell.get(), &cellGraphicsItems[cell->y * grid->getWidth() + cell->x]);
   }
+
+  // Walls change the pruned regions.
+  prunedRegions = nullptr;
+  updatePrunedOverlay();
 }
 
 void GraphicsArea::setStartCellSelected()
@@ -100,6 +132,9 @@ void GraphicsArea::setStartCellSelected()
 
   // Update the start cell pointer.
   startCell = cell;
+
+  // The region containing the start cell is never pruned.
+  updatePrunedOverlay();
 }
 
 void GraphicsArea::setGoalCellSelected()
@@ -129,10 +164,15 @@ void GraphicsArea::setGoalCellSelected()
 
   // Update the goal cell pointer.
   goalCell = cell;
+
+  // The region containing the goal cell is never pruned.
+  updatePrunedOverlay();
 }
 
 void GraphicsArea::resetGrid(int width, int height)
 {
+  endReplay();
+
   // Initialize the grid.
   initGrid(width, height);
 
@@ -144,7 +184,138 @@ void GraphicsArea::resetGrid(int width, int height)
   resizeEvent(nullptr);
 }
 
+void GraphicsArea::setPrunedOverlay(bool show)
+{
+  showPruned = show;
+  updatePrunedOverlay();
+}
+
+void GraphicsArea::loadTrace(const QString& path)
+{
+  // Load the trace first, so that a bad file leaves everything as it was.
+  std::shared_ptr<SearchTrace> trace = std::make_shared<SearchTrace>();
+  if (!trace->load(path.toStdString())) {
+    QMessageBox::warning(this, "Load Trace", "The file is not a valid search trace.");
+    return;
+  }
+
+  // Stop any simulation.
+  GlobalState& globalState = GlobalState::singleton();
+  globalState.setSimState(GlobalState::SimState::STOPPED);
+  globalState.setSimType(GlobalState::SimType::NONE);
+
+  // Rebuild the traced grid as it was before the search.
+  initGrid(trace->width(), trace->height());
+  std::vector<Cell::VisualizationState> states;
+  trace->seek(0, states);
+  for (int i = 0; i < trace->width() * trace->height(); i++) {
+    std::shared_ptr<Cell> cell = grid->grid[i];
+    grid->setCost(cell, trace->costs()[i]);
+    cell->vis = states[i];
+    if (cell->vis == Cell::VisualizationState::START) {
+      startCell = cell;
+    } else if (cell->vis == Cell::VisualizationState::GOAL) {
+      goalCell = cell;
+    }
+  }
+  drawGrid();
+  graphicsScene->setSceneRect(0, 0, trace->width() * cellDisplaySize,
+      trace->height() * cellDisplaySize);
+  resizeEvent(nullptr);
+
+  // Show the search rather than the edit highlights until the grid is edited.
+  editMode = false;
+  replaying = true;
+  GameLoop& gameLoop = GameLoop::singleton();
+  gameLoop.setTrace(trace, grid);
+}
+
+void GraphicsArea::loadMap(const QString& path)
+{
+  // Load the map first, so that a bad file leaves everything as it was.
+  const std::string file = path.toStdString();
+  std::shared_ptr<Grid> map;
+  int start = -1;
+  int goal = -1;
+  if (MovingAI::isScenarioPath(file)) {
+    std::vector<MovingAI::Scenario> scenarios;
+    if (!MovingAI::loadScenarios(file, scenarios) || scenarios.empty()) {
+      QMessageBox::warning(
+          this, "Load Scenario", "The file is not a valid Moving AI scenario.");
+      return;
+    }
+    bool chosen = false;
+    const int query = QInputDialog::getInt(this, "Load Scenario",
+        "Query (0 to " + QString::number(scenarios.size() - 1) + "):", 0, 0,
+        (int)scenarios.size() - 1, 1, &chosen);
+    if (!chosen) {
+      return;
+    }
+    const MovingAI::Scenario& scenario = scenarios[query];
+    const std::string mapFile = MovingAI::mapPath(file, scenario);
+    if (mapFile.empty() || !MovingAI::loadMap(mapFile, map)
+        || map->getWidth() != scenario.mapWidth
+        || map->getHeight() != scenario.mapHeight) {
+      QMessageBox::warning(this, "Load Scenario",
+          "The map of the scenario could not be found next to it, or does not match.");
+      return;
+    }
+    start = scenario.startY * scenario.mapWidth + scenario.startX;
+    goal = scenario.goalY * scenario.mapWidth + scenario.goalX;
+  } else {
+    if (!MovingAI::loadMap(file, map)) {
+      QMessageBox::warning(this, "Load Map", "The file is not a valid Moving AI map.");
+      return;
+    }
+    if (!map->largestRegionEnds(start, goal)) {
+      QMessageBox::warning(
+          this, "Load Map", "The map has no two connected passable cells.");
+      return;
+    }
+  }
+
+  showGrid(map, start, goal);
+}
+
+void GraphicsArea::saveSnapshot(const QString& path)
+{
+  const int start = startCell->y * grid->getWidth() + startCell->x;
+  const int goal = goalCell->y * grid->getWidth() + goalCell->x;
+  if (!GridSnapshot::save(path.toStdString(), *grid, start, goal)) {
+    QMessageBox::warning(this, "Save Snapshot",
+        "The snapshot could not be written. Costs above "
+            + QString::number(GridSnapshot::MAX_COST) + " can't be saved.");
+  }
+}
+
+void GraphicsArea::loadSnapshot(const QString& path)
+{
+  GridSnapshot snapshot;
+  if (!snapshot.open(path.toStdString()) || snapshot.start() == -1
+      || snapshot.goal() == -1) {
+    QMessageBox::warning(this, "Load Snapshot", "The file is not a valid snapshot.");
+    return;
+  }
+  showGrid(snapshot.grid(), snapshot.start(), snapshot.goal());
+}
+
+void GraphicsArea::generateMap(const MapGenerator::Settings& settings)
+{
+  const MapGenerator::Map map = MapGenerator::generate(settings);
+  if (map.start == -1) {
+    QMessageBox::warning(
+        this, "Generate Map", "The generated map has no two connected passable cells.");
+    return;
+  }
+  showGrid(map.grid, map.start, map.goal);
+}
+
 void GraphicsArea::initGrid(int width, int height)
+{
+  initGrid(std::make_shared<Grid>(width, height), 0, width * height - 1);
+}
+
+void GraphicsArea::initGrid(std::shared_ptr<Grid> grid, int start, int goal)
 {
   // Delete the old graphics items.
   graphicsScene->clear();
@@ -153,18 +324,28 @@ void GraphicsArea::initGrid(int width, int height)
   }
   cellGraphicsItems = nullptr;
 
-  // Create a new grid.
-  grid = std::make_shared<Grid>(width, height);
+  // Use the new grid.
+  this->grid = std::move(grid);
+
+  // Loaded and generated grids only carry costs, so show their walls as walls.
+  const int cellCount = this->grid->getWidth() * this->grid->getHeight();
+  for (int i = 0; i < cellCount; i++) {
+    if (this->grid->grid[i]->cost == Cell::WALL_COST) {
+      this->grid->grid[i]->vis = Cell::VisualizationState::WALL;
+    }
+  }
 
   // Set start and goal cells.
-  startCell = grid->getCell(0, 0);
-  goalCell = grid->getCell(width - 1, height - 1);
+  startCell = this->grid->grid[start];
+  goalCell = this->grid->grid[goal];
   startCell->vis = Cell::VisualizationState::START;
   goalCell->vis = Cell::VisualizationState::GOAL;
 }
 
 void GraphicsArea::drawGrid()
 {
+  PROFILE_SCOPE("GraphicsArea::drawGrid");
+
   // Clear old graphics items.
   graphicsScene->clear();
   if (cellGraphicsItems != nullptr) {
@@ -180,6 +361,8 @@ void GraphicsArea::drawGrid()
    */
 
   cellGraphicsItems = new CellGraphicsItem[width * height];
+  dirtyCells.assign(width * height, false);
+  dirtyIndices.clear();
 
   // Create a cosmetic pen for the cell borders.
   // This will make the pen width independent of the zoom level.
@@ -192,6 +375,14 @@ void GraphicsArea::drawGrid()
   QPen highlightPen(Qt::yellow);
   highlightPen.setWidth(bw);
 
+  // Create brush for pruned cells.
+  QBrush prunedBrush(Qt::darkGray, Qt::BDiagPattern);
+
+  // Create a cosmetic pen for links between cells.
+  QPen linkPen(Qt::darkBlue);
+  linkPen.setWidth(2);
+  linkPen.setCosmetic(true);
+
   for (int x = 0; x < width; ++x) {
     for (int y = 0; y < height; ++y) {
 
@@ -214,6 +405,14 @@ void GraphicsArea::drawGrid()
       item.highlight->setZValue(1);
       item.highlight->hide();
 
+      // Setup pruned overlay.
+      item.pruned = new QGraphicsRectItem(x * cellDisplaySize, y * cellDisplaySize,
+          cellDisplaySize, cellDisplaySize, item.rect);
+      item.pruned->setPen(Qt::NoPen);
+      item.pruned->setBrush(prunedBrush);
+      item.pruned->setZValue(2);
+      item.pruned->hide();
+
       // Setup cost text.
       item.text = new QGraphicsTextItem(item.rect);
       item.text->setZValue(3);
@@ -230,13 +429,26 @@ void GraphicsArea::drawGrid()
       item.text_br = new QGraphicsTextItem(item.rect);
       item.text_br->setZValue(3);
 
+      // Setup link segment.
+      // This is not a child of the rectangle, since it can reach across other cells.
+      item.link = new QGraphicsLineItem();
+      item.link->setPen(linkPen);
+      item.link->setZValue(4);
+      item.link->hide();
+
       // Update the graphics of the cell.
       updateCellGraphics(grid->getCell(x, y).get(), &item);
 
-      // Add the item to the scene.
+      // Add the items to the scene.
       graphicsScene->addItem(item.rect);
+      graphicsScene->addItem(item.link);
     }
   }
+
+  // Show pruned regions for the new grid, whose overlay items all start out hidden.
+  prunedRegions = nullptr;
+  prunedOverlayShown = false;
+  updatePrunedOverlay();
 }
 
 /*
@@ -247,6 +459,15 @@ void GraphicsArea::simTypeSlot(GlobalState::SimType type)
 {
   // Enable/disable editing mode.
   editMode = (type == GlobalState::SimType::NONE);
+  replaying = false;
+
+  // Stop the current search before touching the grid it is searching.
+  GameLoop& gameLoop = GameLoop::singleton();
+  gameLoop.setSim(nullptr);
+
+  // Start counting repaints afresh.
+  cellUpdates = 0;
+  cellRepaints = 0;
 
   // Loop endtire grid and update graphics.
   for (int x = 0; x < grid->getWidth(); ++x) {
@@ -254,10 +475,11 @@ void GraphicsArea::simTypeSlot(GlobalState::SimType type)
       auto cell = grid->getCell(x, y);
       cell->selected = false; // Deselect all cells.
 
-      // Clear corner text.
+      // Clear corner text and links.
       cell->text_tr = "";
       cell->text_bl = "";
       cell->text_br = "";
+      cell->link = nullptr;
 
       // Clear path and list visualization.
       switch (cell->vis) {
@@ -274,31 +496,86 @@ void GraphicsArea::simTypeSlot(GlobalState::SimType type)
   }
 
   // Create search algorithm.
-  GameLoop& gameLoop = GameLoop::singleton();
+
+  // Find regions that the search may skip.
+  std::shared_ptr<SearchAlgorithms::DeadEndPruning> pruning = nullptr;
+  if (type == GlobalState::SimType::DIJKSTRA || type == GlobalState::SimType::ASTAR
+      || type == GlobalState::SimType::FRINGE) {
+    pruning = std::make_shared<SearchAlgorithms::DeadEndPruning>(*grid);
+  }
 
   switch (type) {
   case GlobalState::SimType::NONE:
     gameLoop.setSim(nullptr);
     break;
   case GlobalState::SimType::DIJKSTRA:
-    gameLoop.setSim(
-        std::make_shared<SearchAlgorithms::Dijkstra>(grid, startCell, goalCell));
+    // On uniform-cost grids a BFS finds the same paths without a priority queue.
+    if (SearchAlgorithms::BitBFS::applicable(*grid, startCell)) {
+      std::cout << "Uniform cost grid, using bit-parallel BFS." << std::endl;
+      gameLoop.setSim(std::make_shared<SearchAlgorithms::BitBFS>(
+                          grid, startCell, goalCell, pruning),
+          grid);
+    } else {
+      gameLoop.setSim(std::make_shared<SearchAlgorithms::Dijkstra>(
+                          grid, startCell, goalCell, pruning),
+          grid);
+    }
     break;
   case GlobalState::SimType::ASTAR:
     gameLoop.setSim(
-        std::make_shared<SearchAlgorithms::AStar>(grid, startCell, goalCell));
+        std::make_shared<SearchAlgorithms::AStar>(grid, startCell, goalCell, pruning),
+        grid);
+    break;
+  case GlobalState::SimType::HDA_STAR:
+    gameLoop.setSim(
+        std::make_shared<SearchAlgorithms::HDAStar>(grid, startCell, goalCell), grid);
+    break;
+  case GlobalState::SimType::SUBGOAL:
+    gameLoop.setSim(
+        std::make_shared<SearchAlgorithms::SubgoalSearch>(grid, startCell, goalCell,
+            std::make_shared<SearchAlgorithms::SubgoalGraph>(*grid)),
+        grid);
+    break;
+  case GlobalState::SimType::THETA_STAR:
+    gameLoop.setSim(
+        std::make_shared<SearchAlgorithms::ThetaStar>(grid, startCell, goalCell), grid);
+    break;
+  case GlobalState::SimType::LAZY_THETA_STAR:
+    gameLoop.setSim(
+        std::make_shared<SearchAlgorithms::ThetaStar>(grid, startCell, goalCell, true),
+        grid);
+    break;
+  case GlobalState::SimType::FRINGE:
+    gameLoop.setSim(std::make_shared<SearchAlgorithms::FringeSearch>(
+                        grid, startCell, goalCell, pruning),
+        grid);
     break;
   default:
     break;
   }
 }
 
+void GraphicsArea::simStateSlot(GlobalState::SimState state)
+{
+  // Report how well repaints were coalesced whenever the search stops running.
+  if (state != GlobalState::SimState::RUNNING && cellRepaints > 0) {
+    std::cout << "Repainted " << cellRepaints << " cells for " << cellUpdates
+              << " cell updates (coalescing ratio " << coalescingRatio() << ")"
+              << std::endl;
+  }
+}
+
 /*
  * Getters.
  */
 
 std::shared_ptr<Grid> GraphicsArea::getGrid() const { return grid; }
 
+double GraphicsArea::coalescingRatio() const
+{
+  return cellRepaints > 0 ? (double)cellUpdates / cellRepaints : 1;
+}
+
 /*
  * Resize handlers.
  */
@@ -310,6 +587,16 @@ void GraphicsArea::resizeEvent(QResizeEvent* event)
 
 void GraphicsArea::showEvent(QShowEvent* event) { resizeEvent(nullptr); }
 
+/*
+ * Paint handler.
+ */
+
+void GraphicsArea::paintEvent(QPaintEvent* event)
+{
+  PROFILE_SCOPE("GraphicsArea::paintEvent");
+  QGraphicsView::paintEvent(event);
+}
+
 /*
  * Mouse event handlers.
  * These are used to select/deselect cells.
@@ -317,6 +604,7 @@ void GraphicsArea::showEvent(QShowEvent* event) { resizeEvent(nullptr); }
 
 void GraphicsArea::mousePressEvent(QMouseEvent* event)
 {
+  endReplay();
   if (!editMode) {
     return;
   }
@@ -471,18 +759,44 @@ void GraphicsArea::keyPressEvent(QKeyEvent* event)
     if (cell == startCell || cell == goalCell) {
       continue;
     } else {
-      cell->cost = offset;
+      grid->setCost(cell, offset);
       cell->vis = Cell::VisualizationState::UNVISITED;
     }
     updateCellGraphics(
         cell.get(), &cellGraphicsItems[cell->y * grid->getWidth() + cell->x]);
   }
+
+  // Costs change the swamps.
+  prunedRegions = nullptr;
+  updatePrunedOverlay();
 }
 
 /*
  * Private.
  */
 
+void GraphicsArea::endReplay()
+{
+  if (replaying) {
+    simTypeSlot(GlobalState::SimType::NONE);
+  }
+}
+
+void GraphicsArea::showGrid(std::shared_ptr<Grid> grid, int start, int goal)
+{
+  // Stop any simulation.
+  GlobalState& globalState = GlobalState::singleton();
+  globalState.setSimState(GlobalState::SimState::STOPPED);
+  globalState.setSimType(GlobalState::SimType::NONE);
+
+  const int width = grid->getWidth();
+  const int height = grid->getHeight();
+  initGrid(std::move(grid), start, goal);
+  drawGrid();
+  graphicsScene->setSceneRect(0, 0, width * cellDisplaySize, height * cellDisplaySize);
+  resizeEvent(nullptr);
+}
+
 void GraphicsArea::updateCellGraphics(Cell* cell, CellGraphicsItem* graphics)
 {
   // Set highlight pen.
@@ -582,6 +896,17 @@ void GraphicsArea::updateCellGraphics(Cell* cell, CellGraphicsItem* graphics)
     }
   }
 
+  // Draw the segment from the center of the cell to the center of its linked cell.
+  if (cell->link != nullptr) {
+    const qreal half = cellDisplaySize / 2.0;
+    graphics->link->setLine(cell->x * cellDisplaySize + half,
+        cell->y * cellDisplaySize + half, cell->link->x * cellDisplaySize + half,
+        cell->link->y * cellDisplaySize + half);
+    graphics->link->show();
+  } else {
+    graphics->link->hide();
+  }
+
   // Set font size.
   QFont font = graphics->text->font();
   font.setPointSize(cellDisplaySize / 4);
@@ -597,7 +922,8 @@ void GraphicsArea::updateCellGraphics(Cell* cell, CellGraphicsItem* graphics)
 
   // Set cell name.
   font.setPointSize(cellDisplaySize / 5);
-  graphics->name->setPlainText(QString::fromStdString(cell->name));
+  graphics->name->setPlainText(QString::fromStdString(
+      Grid::cellName(cell->y * grid->getWidth() + cell->x)));
   graphics->name->setFont(font);
 
   // Set cell corner text.
@@ -623,4 +949,29 @@ void GraphicsArea::updateCellGraphics(Cell* cell, CellGraphicsItem* graphics)
   QRectF rect_br = graphics->text_br->boundingRect();
   graphics->text_br->setPos(x + cellDisplaySize - rect_br.width() + 3,
       y + cellDisplaySize - rect_br.height() + 3);
+}
+
+void GraphicsArea::updatePrunedOverlay()
+{
+  const int size = grid->getWidth() * grid->getHeight();
+
+  // Hide the overlay if it is disabled, unless it already is.
+  if (!showPruned) {
+    for (int i = 0; prunedOverlayShown && i < size; i++) {
+      cellGraphicsItems[i].pruned->hide();
+    }
+    prunedOverlayShown = false;
+    return;
+  }
+
+  // Show every cell that a search between the current start and goal would skip.
+  if (prunedRegions == nullptr) {
+    prunedRegions = std::make_shared<SearchAlgorithms::DeadEndPruning>(*grid);
+  }
+  const int start = startCell->y * grid->getWidth() + startCell->x;
+  const int goal = goalCell->y * grid->getWidth() + goalCell->x;
+  for (int i = 0; i < size; i++) {
+    cellGraphicsItems[i].pruned->setVisible(prunedRegions->pruned(i, start, goal));
+  }
+  prunedOverlayShown = true;
 }
\ No newline at end of file
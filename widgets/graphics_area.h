@@ -1,6 +1,7 @@
 #ifndef GRAPHICS_AREA_H
 #define GRAPHICS_AREA_H
 
+#include <QGraphicsLineItem>
 #include <QGraphicsRectItem>
 #include <QGraphicsScene>
 #include <QGraphicsTextItem>
@@ -12,7 +13,10 @@
 #include <set>
 #include <vector>
 
+#include "../algorithms/cell_events.h"
+#include "../algorithms/dead_end_pruning.h"
 #include "../global_state.h"
+#include "../map_generator.h"
 #include "grid.h"
 
 /**
@@ -26,9 +30,9 @@ class GraphicsArea : public QGraphicsView {
   /**
    * Update the existing cells in the grid.
    *
-   * \param cells The cells to update.
+   * \param events The cells that changed.
    */
-  void updateCells(std::vector<std::shared_ptr<Grid::Cell>> cells);
+  void updateCells(const SearchAlgorithms::CellEventBuffer& events);
 
   /**
    * Update the current interaction mode.
@@ -65,6 +69,57 @@ class GraphicsArea : public QGraphicsView {
    */
   void resetGrid(int width, int height);
 
+  /**
+   * Show or hide the overlay of pruned regions.
+   * Pruned regions are the dead ends and swamps that a search between the current
+   * start and goal cells may skip.
+   *
+   * \param show True to show the overlay.
+   */
+  void setPrunedOverlay(bool show);
+
+  /**
+   * Load a trace and replay it on a new grid of the traced size.
+   * Any running simulation is stopped first. Editing the grid ends the replay.
+   *
+   * \param path The path of the trace file.
+   */
+  void loadTrace(const QString& path);
+
+  /**
+   * Load a Moving AI map, or a query of a Moving AI scenario along with its map.
+   * The user is asked which query of a scenario file to load. A map on its own is
+   * searched between the first and last cells of its largest connected region. Any
+   * running simulation is stopped first.
+   *
+   * \param path The path of the `.map` or `.scen` file.
+   */
+  void loadMap(const QString& path);
+
+  /**
+   * Save the grid, with its start and goal cells, as a grid snapshot.
+   * The user is told if the grid can't be saved.
+   *
+   * \param path The path of the `.grid` file.
+   */
+  void saveSnapshot(const QString& path);
+
+  /**
+   * Load a grid snapshot, with its start and goal cells.
+   * Any running simulation is stopped first.
+   *
+   * \param path The path of the `.grid` file.
+   */
+  void loadSnapshot(const QString& path);
+
+  /**
+   * Generate a map in place of the grid, searched between the first and last cells of
+   * its largest connected region. Any running simulation is stopped first.
+   *
+   * \param settings What to generate.
+   */
+  void generateMap(const MapGenerator::Settings& settings);
+
   private slots:
   /**
    * Update editability based on simulation type.
@@ -74,6 +129,13 @@ class GraphicsArea : public QGraphicsView {
    */
   void simTypeSlot(GlobalState::SimType type);
 
+  /**
+   * Update the simulation state.
+   *
+   * \param state The simulation state.
+   */
+  void simStateSlot(GlobalState::SimState state);
+
   signals:
 
   /**
@@ -104,6 +166,16 @@ class GraphicsArea : public QGraphicsView {
    */
   void initGrid(int width, int height);
 
+  /**
+   * Initialize the grid with an existing grid.
+   * If a grid already exists, it will be dereferenced.
+   *
+   * \param grid The new grid.
+   * \param start The index of the start cell.
+   * \param goal The index of the goal cell.
+   */
+  void initGrid(std::shared_ptr<Grid> grid, int start, int goal);
+
   /**
    * (Re)draw the grid.
    * This will clear the scene and redraw the grid.
@@ -117,6 +189,14 @@ class GraphicsArea : public QGraphicsView {
    */
   std::shared_ptr<Grid> getGrid() const;
 
+  /**
+   * Get how many cell updates there were per cell repaint in the current search.
+   * Repeated updates to a cell within one frame are coalesced into a single repaint.
+   *
+   * \return The number of cell updates divided by the number of cell repaints.
+   */
+  double coalescingRatio() const;
+
   /*
    * Event handlers.
    */
@@ -139,6 +219,14 @@ class GraphicsArea : public QGraphicsView {
    */
   void showEvent(QShowEvent* event) override;
 
+  /**
+   * Handle a paint event.
+   * This paints the scene as usual, timing it for the profiler.
+   *
+   * \param event The paint event.
+   */
+  void paintEvent(QPaintEvent* event) override;
+
   /**
    * Handle a mouse press event.
    * This will select/deselect cells in the grid.
@@ -185,10 +273,16 @@ class GraphicsArea : public QGraphicsView {
     QGraphicsTextItem* text_tr = nullptr; // Text in the top right corner of the cell.
     QGraphicsTextItem* text_bl = nullptr; // Text in the bottom left corner of the cell.
     QGraphicsTextItem* text_br = nullptr; // Text in the bottom right corner.
+    QGraphicsRectItem* pruned = nullptr; // Hatching shown over a pruned cell.
+    QGraphicsLineItem* link = nullptr; // The segment to the cell's linked cell.
   };
 
   CellGraphicsItem* cellGraphicsItems
       = nullptr; // The graphics items representing the cells in the grid.
+  std::vector<bool> dirtyCells; // Whether each cell is waiting to be repainted.
+  std::vector<int> dirtyIndices; // The indices of the cells waiting to be repainted.
+  unsigned long cellUpdates = 0; // The number of cell updates in the current search.
+  unsigned long cellRepaints = 0; // The number of cell repaints in the current search.
 
   /**
    * Update the graphics of a cell.
@@ -200,6 +294,27 @@ class GraphicsArea : public QGraphicsView {
    */
   void updateCellGraphics(Grid::Cell* cell, CellGraphicsItem* graphics);
 
+  /**
+   * Stop replaying a loaded trace, if one is being replayed, and go back to editing.
+   */
+  void endReplay();
+
+  /**
+   * Stop any simulation and show a loaded grid in place of the current one.
+   *
+   * \param grid The loaded grid.
+   * \param start The index of the start cell.
+   * \param goal The index of the goal cell.
+   */
+  void showGrid(std::shared_ptr<Grid> grid, int start, int goal);
+
+  /**
+   * Update the overlay of pruned regions for the current start and goal.
+   * The regions are only recomputed if they are out of date, and not at all while the
+   * overlay is disabled. Whoever changes the costs must set `prunedRegions` to nullptr.
+   */
+  void updatePrunedOverlay();
+
   /*
    * Data.
    */
@@ -207,6 +322,11 @@ class GraphicsArea : public QGraphicsView {
   int cellDisplaySize = 24; // The size of each cell in the grid (in pixels).
 
   bool editMode = true; // True if the edit mode is active, false otherwise.
+  bool showPruned = false; // True if pruned regions should be shown.
+  bool prunedOverlayShown = false; // True if any pruned cell is being shown.
+  std::shared_ptr<const SearchAlgorithms::DeadEndPruning>
+      prunedRegions; // The pruned regions of the grid, or nullptr if out of date.
+  bool replaying = false; // True if a loaded trace is being shown.
   std::set<std::shared_ptr<Grid::Cell>> selected; // The selected cells.
 
   /*
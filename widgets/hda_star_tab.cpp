@@ -0,0 +1,16 @@
+#include "hda_star_tab.h"
+
+HDAStarTab::HDAStarTab(QWidget* parent)
+    : QWidget(parent)
+{
+  // Create the simulation parameters.
+  simParams = new SimParams(GlobalState::SimType::HDA_STAR, this);
+
+  // Create the layout.
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(simParams);
+  layout->addStretch();
+  setLayout(layout);
+}
+
+HDAStarTab::~HDAStarTab() { }
\ No newline at end of file
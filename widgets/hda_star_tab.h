@@ -0,0 +1,33 @@
+#ifndef HDA_STAR_TAB_H
+#define HDA_STAR_TAB_H
+
+#include <QWidget>
+
+#include "sim_params.h"
+
+class HDAStarTab : public QWidget {
+  Q_OBJECT
+
+  public:
+  /**
+   * Construct a new HDA* Tab.
+   *
+   * \param parent The parent widget.
+   */
+  HDAStarTab(QWidget* parent = nullptr);
+
+  /**
+   * Destroy an HDA* Tab.
+   */
+  ~HDAStarTab();
+
+  private:
+
+  /*
+   * Widgets.
+   */
+
+  SimParams* simParams; // The simulation parameters.
+};
+
+#endif // HDA_STAR_TAB_H
\ No newline at end of file
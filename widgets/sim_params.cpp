@@ -1,4 +1,12 @@
 #include "sim_params.h"
+#include "../game_loop.h"
+#include "../profiler.h"
+
+#include <QFileDialog>
+#include <QMessageBox>
+
+#include <cmath>
+#include <fstream>
 
 using SimState = GlobalState::SimState;
 using SimType = GlobalState::SimType;
@@ -19,15 +27,44 @@ SimParams::SimParams(SimType simType, QWidget* parent)
   drawCheckBox = new QCheckBox("Draw", this);
   drawCheckBox->setChecked(globalState.draw());
   connect(drawCheckBox, &QCheckBox::stateChanged, this, &SimParams::drawClicked);
+  smoothPathsCheckBox = new QCheckBox("Smooth path", this);
+  smoothPathsCheckBox->setChecked(globalState.smoothPaths());
+  connect(smoothPathsCheckBox, &QCheckBox::stateChanged, this,
+      &SimParams::smoothPathsClicked);
 
-  // Create slider.
+  // Create slider. Its positions are spaced logarithmically, with the last one being an
+  // unlimited speed.
   int simSpeed = globalState.simSpeed();
-  speedLabel = new QLabel("Speed (" + QString::number(simSpeed) + " ticks/sec)", this);
+  speedLabel = new QLabel(speedText(simSpeed), this);
   speedSlider = new QSlider(Qt::Horizontal, this);
-  speedSlider->setRange(1, 100);
-  speedSlider->setValue(simSpeed);
+  speedSlider->setRange(0, sliderPosition(GlobalState::UNLIMITED_SIM_SPEED));
+  speedSlider->setValue(sliderPosition(simSpeed));
   connect(speedSlider, &QSlider::valueChanged, this, &SimParams::speedChanged);
 
+  // Create progress indicators for searches that are not drawn.
+  progressBar = new QProgressBar(this);
+  progressBar->setVisible(false);
+  headlessLabel = new QLabel(this);
+  headlessLabel->setWordWrap(true);
+  headlessLabel->setVisible(false);
+
+  // Create the counters of the current search.
+  countersLabel = new QLabel(this);
+  countersLabel->setVisible(false);
+  saveCountersButton = new QPushButton("Save counters", this);
+  saveCountersButton->setVisible(false);
+  connect(saveCountersButton, &QPushButton::clicked, this,
+      &SimParams::saveCountersClicked);
+
+  // Create the profiler controls. Timings are saved as a Chrome trace, which can be
+  // opened in chrome://tracing or Perfetto.
+  profileCheckBox = new QCheckBox("Record timings", this);
+  profileCheckBox->setChecked(globalState.profile());
+  connect(profileCheckBox, &QCheckBox::stateChanged, this, &SimParams::profileClicked);
+  saveProfileButton = new QPushButton("Save timings", this);
+  connect(saveProfileButton, &QPushButton::clicked, this,
+      &SimParams::saveProfileClicked);
+
   // Create buttons.
   startButton = new QPushButton("Start", this);
   connect(startButton, &QPushButton::clicked, this, &SimParams::startClicked);
@@ -51,8 +88,15 @@ SimParams::SimParams(SimType simType, QWidget* parent)
   // Create layout for params widget.
   paramsLayout = new QVBoxLayout();
   paramsLayout->addWidget(drawCheckBox);
+  paramsLayout->addWidget(smoothPathsCheckBox);
   paramsLayout->addWidget(speedLabel);
   paramsLayout->addWidget(speedSlider);
+  paramsLayout->addWidget(progressBar);
+  paramsLayout->addWidget(headlessLabel);
+  paramsLayout->addWidget(countersLabel);
+  paramsLayout->addWidget(saveCountersButton);
+  paramsLayout->addWidget(profileCheckBox);
+  paramsLayout->addWidget(saveProfileButton);
   paramsLayout->addLayout(buttonLayout);
 
   // Create widget to hold parameters.
@@ -78,6 +122,17 @@ SimParams::SimParams(SimType simType, QWidget* parent)
   connect(&globalState, &GlobalState::simTypeChanged, this, &SimParams::simTypeSlot);
   connect(&globalState, &GlobalState::simSpeedChanged, this, &SimParams::speedSlot);
   connect(&globalState, &GlobalState::drawChanged, this, &SimParams::drawSlot);
+  connect(&globalState, &GlobalState::smoothPathsChanged, this,
+      &SimParams::smoothPathsSlot);
+  connect(&globalState, &GlobalState::profileChanged, this, &SimParams::profileSlot);
+
+  // Connect signals from the game loop.
+  GameLoop& gameLoop = GameLoop::singleton();
+  connect(&gameLoop, &GameLoop::headlessProgress, this,
+      &SimParams::headlessProgressSlot);
+  connect(&gameLoop, &GameLoop::headlessFinished, this,
+      &SimParams::headlessFinishedSlot);
+  connect(&gameLoop, &GameLoop::countersChanged, this, &SimParams::countersSlot);
 }
 
 SimParams::~SimParams() { }
@@ -88,10 +143,20 @@ SimParams::~SimParams() { }
 
 void SimParams::drawSlot(bool checked) { drawCheckBox->setChecked(checked); }
 
+void SimParams::smoothPathsSlot(bool checked)
+{
+  smoothPathsCheckBox->setChecked(checked);
+}
+
+void SimParams::profileSlot(bool checked)
+{
+  profileCheckBox->setChecked(checked);
+}
+
 void SimParams::speedSlot(int value)
 {
-  speedSlider->setValue(value);
-  speedLabel->setText("Speed (" + QString::number(value) + " ticks/sec)");
+  speedSlider->setValue(sliderPosition(value));
+  speedLabel->setText(speedText(value));
 }
 
 void SimParams::simStateSlot(SimState state)
@@ -103,6 +168,37 @@ void SimParams::simStateSlot(SimState state)
 
 void SimParams::simTypeSlot(GlobalState::SimType type) { updateLayoutSimType(type); }
 
+void SimParams::headlessProgressSlot(unsigned long expansions, int cells)
+{
+  // The closed set can't outgrow the grid, so the grid size bounds the bar.
+  progressBar->setRange(0, cells);
+  progressBar->setValue(expansions < (unsigned long)cells ? expansions : cells);
+  progressBar->setFormat(QString::number(expansions) + " expansions");
+  progressBar->setVisible(true);
+  headlessLabel->setVisible(false);
+}
+
+void SimParams::headlessFinishedSlot(unsigned long expansions, double milliseconds)
+{
+  QString text = QString::number(expansions) + " expansions in "
+      + QString::number(milliseconds, 'f', 1) + " ms";
+  if (milliseconds > 0) {
+    text += " (" + QString::number(expansions * 1000.0 / milliseconds, 'f', 0)
+        + " expansions/sec)";
+  }
+  headlessLabel->setText(text);
+  headlessLabel->setVisible(true);
+  progressBar->setVisible(false);
+}
+
+void SimParams::countersSlot(const SearchAlgorithms::SearchCounters& counters)
+{
+  this->counters = counters;
+  countersLabel->setText(countersText(counters));
+  countersLabel->setVisible(true);
+  saveCountersButton->setVisible(true);
+}
+
 /*
  * Private slots.
  */
@@ -113,10 +209,22 @@ void SimParams::drawClicked(int state)
   globalState.setDraw(state == Qt::Checked);
 }
 
+void SimParams::smoothPathsClicked(int state)
+{
+  GlobalState& globalState = GlobalState::singleton();
+  globalState.setSmoothPaths(state == Qt::Checked);
+}
+
+void SimParams::profileClicked(int state)
+{
+  GlobalState& globalState = GlobalState::singleton();
+  globalState.setProfile(state == Qt::Checked);
+}
+
 void SimParams::speedChanged(int value)
 {
   GlobalState& globalState = GlobalState::singleton();
-  globalState.setSimSpeed(value);
+  globalState.setSimSpeed(sliderSpeed(value));
 }
 
 void SimParams::startClicked()
@@ -145,10 +253,78 @@ void SimParams::resetClicked()
   globalState.setSimType(SimType::NONE);
 }
 
+void SimParams::saveCountersClicked()
+{
+  QString path = QFileDialog::getSaveFileName(
+      this, "Save Counters", QString(), "JSON files (*.json)");
+  if (path.isEmpty()) {
+    return;
+  }
+  std::ofstream out(path.toStdString());
+  out << counters.json() << std::endl;
+  if (!out) {
+    QMessageBox::warning(this, "Save Counters", "The counters could not be saved.");
+  }
+}
+
+void SimParams::saveProfileClicked()
+{
+  QString path = QFileDialog::getSaveFileName(
+      this, "Save Timings", QString(), "Chrome traces (*.json)");
+  if (path.isEmpty()) {
+    return;
+  }
+  if (!Profiler::singleton().save(path.toStdString())) {
+    QMessageBox::warning(this, "Save Timings", "The timings could not be saved.");
+  }
+}
+
 /*
  * Private.
  */
 
+int SimParams::sliderSpeed(int position)
+{
+  if (position >= sliderPosition(GlobalState::UNLIMITED_SIM_SPEED)) {
+    return GlobalState::UNLIMITED_SIM_SPEED;
+  }
+  return (int)std::lround(std::pow(10.0, (double)position / SPEED_STEPS_PER_DECADE));
+}
+
+int SimParams::sliderPosition(int speed)
+{
+  // The unlimited speed sits one step past the fastest limited speed.
+  if (speed == GlobalState::UNLIMITED_SIM_SPEED) {
+    return sliderPosition(GlobalState::MAX_SIM_SPEED) + 1;
+  }
+  return (int)std::lround(SPEED_STEPS_PER_DECADE * std::log10((double)speed));
+}
+
+QString SimParams::speedText(int speed)
+{
+  if (speed == GlobalState::UNLIMITED_SIM_SPEED) {
+    return "Speed (unlimited)";
+  }
+  return "Speed (" + QString::number(speed) + " expansions/sec)";
+}
+
+QString SimParams::countersText(const SearchAlgorithms::SearchCounters& counters)
+{
+  QString text = "Expansions: " + QString::number(counters.expansions);
+  if (!SearchAlgorithms::SearchCounters::ENABLED) {
+    return text + "\n(Other counters are disabled in this build.)";
+  }
+  text += "\nPushes: " + QString::number(counters.pushes);
+  text += "\nStale pops: " + QString::number(counters.stalePops);
+  text += "\nDecrease-keys: " + QString::number(counters.decreaseKeys);
+  text += "\nPeak open list: " + QString::number((qulonglong)counters.peakOpen);
+  text += "\nSearch state: "
+      + QString::number(counters.stateBytes / 1024.0, 'f', 1) + " KiB";
+  text += "\nTime per expansion: "
+      + QString::number(counters.millisecondsPerExpansion() * 1000, 'f', 2) + " µs";
+  return text;
+}
+
 void SimParams::updateLayoutSimState(GlobalState::SimState state)
 {
   // Update button visibility based on simulation state.
@@ -170,6 +346,10 @@ void SimParams::updateLayoutSimState(GlobalState::SimState state)
     pauseButton->setVisible(false);
     resumeButton->setVisible(false);
     resetButton->setVisible(false);
+    progressBar->setVisible(false);
+    headlessLabel->setVisible(false);
+    countersLabel->setVisible(false);
+    saveCountersButton->setVisible(false);
     break;
   }
 }
@@ -5,11 +5,13 @@
 #include <QGroupBox>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QSlider>
 #include <QVBoxLayout>
 #include <QWidget>
 
+#include "../algorithms/search_counters.h"
 #include "../global_state.h"
 
 class SimParams : public QWidget {
@@ -24,6 +26,20 @@ class SimParams : public QWidget {
    */
   void drawSlot(bool checked);
 
+  /**
+   * Update the smooth paths check box.
+   *
+   * \param checked Whether or not the check box is checked.
+   */
+  void smoothPathsSlot(bool checked);
+
+  /**
+   * Update the profile check box.
+   *
+   * \param checked Whether or not the check box is checked.
+   */
+  void profileSlot(bool checked);
+
   /**
    * Update the value of the speed slider.
    *
@@ -45,6 +61,29 @@ class SimParams : public QWidget {
    */
   void simTypeSlot(GlobalState::SimType type);
 
+  /**
+   * Show the progress of a search that is not being drawn.
+   *
+   * \param expansions The number of expansions done so far.
+   * \param cells The number of cells in the grid.
+   */
+  void headlessProgressSlot(unsigned long expansions, int cells);
+
+  /**
+   * Show how fast a search that was not being drawn ran.
+   *
+   * \param expansions The number of expansions done without drawing.
+   * \param milliseconds The wall-clock time taken by those expansions.
+   */
+  void headlessFinishedSlot(unsigned long expansions, double milliseconds);
+
+  /**
+   * Show the counts of what the current search has done.
+   *
+   * \param counters The counts.
+   */
+  void countersSlot(const SearchAlgorithms::SearchCounters& counters);
+
   private slots:
 
   /**
@@ -54,6 +93,20 @@ class SimParams : public QWidget {
    */
   void drawClicked(int state);
 
+  /**
+   * Smooth paths check box clicked.
+   *
+   * \param state Checkbox state.
+   */
+  void smoothPathsClicked(int state);
+
+  /**
+   * Profile check box clicked.
+   *
+   * \param state Checkbox state.
+   */
+  void profileClicked(int state);
+
   /**
    * Speed slider value changed.
    *
@@ -81,8 +134,21 @@ class SimParams : public QWidget {
    */
   void resetClicked();
 
+  /**
+   * Save counters button clicked.
+   */
+  void saveCountersClicked();
+
+  /**
+   * Save profile button clicked.
+   */
+  void saveProfileClicked();
+
   public:
 
+  static constexpr int SPEED_STEPS_PER_DECADE
+      = 10; // The number of speed slider positions per factor of ten in speed.
+
   /**
    * Construct a new Sim Params.
    *
@@ -98,6 +164,38 @@ class SimParams : public QWidget {
 
   private:
 
+  /**
+   * Get the simulation speed for a position of the speed slider.
+   *
+   * \param position The position of the speed slider.
+   * \return The simulation speed (expansions/second), or UNLIMITED_SIM_SPEED.
+   */
+  static int sliderSpeed(int position);
+
+  /**
+   * Get the position of the speed slider closest to a simulation speed.
+   *
+   * \param speed The simulation speed (expansions/second), or UNLIMITED_SIM_SPEED.
+   * \return The position of the speed slider.
+   */
+  static int sliderPosition(int speed);
+
+  /**
+   * Get the text of the speed label.
+   *
+   * \param speed The simulation speed (expansions/second), or UNLIMITED_SIM_SPEED.
+   * \return The text of the speed label.
+   */
+  static QString speedText(int speed);
+
+  /**
+   * Get the text of the counters label.
+   *
+   * \param counters The counts of what a search has done.
+   * \return The text of the counters label.
+   */
+  static QString countersText(const SearchAlgorithms::SearchCounters& counters);
+
   /**
    * Update the layout for the simulation state.
    *
@@ -117,6 +215,7 @@ class SimParams : public QWidget {
    */
 
   GlobalState::SimType simType; // The type of simulation that the parameters are for.
+  SearchAlgorithms::SearchCounters counters; // The counts of the last search shown.
 
   /*
    * Widgets.
@@ -128,8 +227,15 @@ class SimParams : public QWidget {
   QWidget* paramsWidget; // The widget for the simulation parameters.
   QVBoxLayout* paramsLayout; // The layout for the simulation parameters.
   QCheckBox* drawCheckBox; // Whether or not to draw a running simulation.
+  QCheckBox* smoothPathsCheckBox; // Whether or not to smooth found paths.
   QLabel* speedLabel; // The label for the simulation speed.
   QSlider* speedSlider; // The slider for the simulation speed.
+  QProgressBar* progressBar; // The progress of a search that is not being drawn.
+  QLabel* headlessLabel; // The speed of a search that was not being drawn.
+  QLabel* countersLabel; // The counts of what the search has done.
+  QPushButton* saveCountersButton; // The button to save the counts as JSON.
+  QCheckBox* profileCheckBox; // Whether or not to record timings for the profiler.
+  QPushButton* saveProfileButton; // The button to save the recorded timings.
   QHBoxLayout* buttonLayout; // The layout for the simulation buttons.
   QPushButton* startButton; // The button to start the simulation.
   QPushButton* pauseButton; // The button to stop the simulation.
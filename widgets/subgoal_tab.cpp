@@ -0,0 +1,16 @@
+#include "subgoal_tab.h"
+
+SubgoalTab::SubgoalTab(QWidget* parent)
+    : QWidget(parent)
+{
+  // Create the simulation parameters.
+  simParams = new SimParams(GlobalState::SimType::SUBGOAL, this);
+
+  // Create the layout.
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(simParams);
+  layout->addStretch();
+  setLayout(layout);
+}
+
+SubgoalTab::~SubgoalTab() { }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef SUBGOAL_TAB_H
+#define SUBGOAL_TAB_H
+
+#include <QWidget>
+
+#include "sim_params.h"
+
+class SubgoalTab : public QWidget {
+  Q_OBJECT
+
+  public:
+  /**
+   * Construct a new Subgoal Tab.
+   *
+   * \param parent The parent widget.
+   */
+  SubgoalTab(QWidget* parent = nullptr);
+
+  /**
+   * Destroy a Subgoal Tab.
+   */
+  ~SubgoalTab();
+
+  private:
+
+  /*
+   * Widgets.
+   */
+
+  SimParams* simParams; // The simulation parameters.
+};
+
+#endif // SUBGOAL_TAB_H
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include "theta_star_tab.h"
+
+ThetaStarTab::ThetaStarTab(GlobalState::SimType type, QWidget* parent)
+    : QWidget(parent)
+{
+  // Create the simulation parameters.
+  simParams = new SimParams(type, this);
+
+  // Create the layout.
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(simParams);
+  layout->addStretch();
+  setLayout(layout);
+}
+
+ThetaStarTab::~ThetaStarTab() { }
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef THETA_STAR_TAB_H
+#define THETA_STAR_TAB_H
+
+#include <QWidget>
+
+#include "sim_params.h"
+
+class ThetaStarTab : public QWidget {
+  Q_OBJECT
+
+  public:
+  /**
+   * Construct a new Theta* Tab.
+   * The same tab is used for Theta* and Lazy Theta*.
+   *
+   * \param type The simulation type (THETA_STAR or LAZY_THETA_STAR).
+   * \param parent The parent widget.
+   */
+  ThetaStarTab(GlobalState::SimType type, QWidget* parent = nullptr);
+
+  /**
+   * Destroy a Theta* Tab.
+   */
+  ~ThetaStarTab();
+
+  private:
+
+  /*
+   * Widgets.
+   */
+
+  SimParams* simParams; // The simulation parameters.
+};
+
+#endif // THETA_STAR_TAB_H
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "trace_controls.h"
+#include "../game_loop.h"
+
+#include <QFileDialog>
+#include <QMessageBox>
+
+TraceControls::TraceControls(QWidget* parent)
+    : QWidget(parent)
+{
+  // Create timeline.
+  timelineSlider = new QSlider(Qt::Horizontal, this);
+  timelineSlider->setRange(0, 0);
+  timelineSlider->setEnabled(false);
+  connect(
+      timelineSlider, &QSlider::valueChanged, this, &TraceControls::timelineChanged);
+  stepLabel = new QLabel(this);
+  updateStepLabel();
+
+  // Create buttons.
+  saveButton = new QPushButton("Save trace", this);
+  saveButton->setEnabled(false);
+  connect(saveButton, &QPushButton::clicked, this, &TraceControls::saveClicked);
+  loadButton = new QPushButton("Load trace", this);
+  connect(loadButton, &QPushButton::clicked, this, &TraceControls::loadClicked);
+
+  // Create layout.
+  layout = new QHBoxLayout(this);
+  layout->addWidget(timelineSlider, 1);
+  layout->addWidget(stepLabel);
+  layout->addWidget(saveButton);
+  layout->addWidget(loadButton);
+  setLayout(layout);
+
+  // Connect signals from the game loop.
+  GameLoop& gameLoop = GameLoop::singleton();
+  connect(&gameLoop, &GameLoop::traceChanged, this, &TraceControls::traceSlot);
+}
+
+TraceControls::~TraceControls() { }
+
+/*
+ * Public slots.
+ */
+
+void TraceControls::traceSlot(int steps)
+{
+  // Start at the end of the trace, which is what the grid already shows.
+  timelineSlider->setRange(0, steps);
+  timelineSlider->setValue(steps);
+  timelineSlider->setEnabled(steps > 0);
+  saveButton->setEnabled(steps > 0);
+  updateStepLabel();
+}
+
+/*
+ * Private slots.
+ */
+
+void TraceControls::timelineChanged(int value)
+{
+  GameLoop& gameLoop = GameLoop::singleton();
+  gameLoop.seekTrace(value);
+  updateStepLabel();
+}
+
+void TraceControls::saveClicked()
+{
+  GameLoop& gameLoop = GameLoop::singleton();
+  std::shared_ptr<SearchTrace> trace = gameLoop.trace();
+  if (trace == nullptr) {
+    return;
+  }
+
+  QString path = QFileDialog::getSaveFileName(
+      this, "Save Trace", QString(), "Search traces (*.trace)");
+  if (path.isEmpty()) {
+    return;
+  }
+  if (!trace->save(path.toStdString())) {
+    QMessageBox::warning(this, "Save Trace", "The trace could not be saved.");
+  }
+}
+
+void TraceControls::loadClicked()
+{
+  QString path = QFileDialog::getOpenFileName(
+      this, "Load Trace", QString(), "Search traces (*.trace)");
+  if (!path.isEmpty()) {
+    emit loadTrace(path);
+  }
+}
+
+/*
+ * Private.
+ */
+
+void TraceControls::updateStepLabel()
+{
+  stepLabel->setText("Step " + QString::number(timelineSlider->value()) + " of "
+      + QString::number(timelineSlider->maximum()));
+}
\ No newline at end of file
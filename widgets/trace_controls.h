@@ -0,0 +1,87 @@
+#ifndef TRACE_CONTROLS_H
+#define TRACE_CONTROLS_H
+
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QSlider>
+#include <QString>
+#include <QWidget>
+
+/**
+ * A timeline for scrubbing through the trace of a finished search, with buttons to save
+ * the trace and to load one that was saved earlier.
+ */
+class TraceControls : public QWidget {
+  Q_OBJECT
+
+  public slots:
+
+  /**
+   * Update the timeline for a new trace.
+   *
+   * \param steps The number of steps in the trace, or 0 if there is nothing to scrub.
+   */
+  void traceSlot(int steps);
+
+  private slots:
+
+  /**
+   * Timeline slider value changed.
+   *
+   * \param value The value of the timeline slider.
+   */
+  void timelineChanged(int value);
+
+  /**
+   * "Save trace" button clicked.
+   */
+  void saveClicked();
+
+  /**
+   * "Load trace" button clicked.
+   */
+  void loadClicked();
+
+  public:
+
+  /**
+   * Construct a new Trace Controls.
+   *
+   * \param parent The parent widget.
+   */
+  TraceControls(QWidget* parent = nullptr);
+
+  /**
+   * Destroy a Trace Controls.
+   */
+  ~TraceControls();
+
+  signals:
+
+  /**
+   * Signal that a trace should be loaded and shown.
+   *
+   * \param path The path of the trace file.
+   */
+  void loadTrace(const QString& path);
+
+  private:
+
+  /**
+   * Update the label that shows the current step.
+   */
+  void updateStepLabel();
+
+  /*
+   * Widgets.
+   */
+
+  QHBoxLayout* layout; // The layout of the controls.
+  QSlider* timelineSlider; // The slider for the step being shown.
+  QLabel* stepLabel; // The label for the step being shown.
+  QPushButton* saveButton; // The button for saving the trace.
+  QPushButton* loadButton; // The button for loading a trace.
+};
+
+#endif // TRACE_CONTROLS_H
\ No newline at end of file